@@ -223,6 +223,59 @@ class DelimitedToArraysTypedGenftREF(DelimitedToArraysTypedGenft):
         _ = self.entry(self.file_like_float, delimiter=',', dtype=float)
 
 
+# #-------------------------------------------------------------------------------
+class DelimitedToArraysFloat(Perf):
+    FUNCTIONS = ('float_short', 'float_long', 'float_exponent')
+
+    COUNT_ROW = 100_000
+    COUNT_COLUMN = 10
+
+    def __init__(self):
+        rng = np.random.default_rng(0)
+        values = rng.random(self.COUNT_ROW * self.COUNT_COLUMN) * 1000
+
+        def file_like(fmt):
+            fields = [fmt.format(v) for v in values]
+            records = (','.join(fields[i: i + self.COUNT_COLUMN])
+                    for i in range(0, len(fields), self.COUNT_COLUMN))
+            return io.StringIO('\n'.join(records))
+
+        self.file_like_short = file_like('{:.3f}')
+        self.file_like_long = file_like('{!r}')
+        self.file_like_exponent = file_like('{:.15e}')
+
+class DelimitedToArraysFloatAK(DelimitedToArraysFloat):
+    entry = staticmethod(delimited_to_arrays_ak)
+    dtypes = ([float] * DelimitedToArraysFloat.COUNT_COLUMN).__getitem__
+
+    def float_short(self):
+        self.file_like_short.seek(0)
+        _ = self.entry(self.file_like_short, dtypes=self.dtypes, axis=1)
+
+    def float_long(self):
+        self.file_like_long.seek(0)
+        _ = self.entry(self.file_like_long, dtypes=self.dtypes, axis=1)
+
+    def float_exponent(self):
+        self.file_like_exponent.seek(0)
+        _ = self.entry(self.file_like_exponent, dtypes=self.dtypes, axis=1)
+
+class DelimitedToArraysFloatREF(DelimitedToArraysFloat):
+    entry = staticmethod(np.loadtxt)
+
+    def float_short(self):
+        self.file_like_short.seek(0)
+        _ = self.entry(self.file_like_short, delimiter=',', dtype=float)
+
+    def float_long(self):
+        self.file_like_long.seek(0)
+        _ = self.entry(self.file_like_long, delimiter=',', dtype=float)
+
+    def float_exponent(self):
+        self.file_like_exponent.seek(0)
+        _ = self.entry(self.file_like_exponent, delimiter=',', dtype=float)
+
+
 # #-------------------------------------------------------------------------------
 # class DelimitedToArraysParsedGenft(FixtureFileLike, Perf):
 #     NUMBER = 10
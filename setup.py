@@ -1,5 +1,6 @@
 import site
 import os
+import sys
 import typing as tp
 from setuptools import Extension  # type: ignore
 from setuptools import setup
@@ -30,13 +31,16 @@ def get_ext_dir(*components: tp.Iterable[str]) -> tp.Sequence[str]:
             dirs.append(fp)
     return dirs
 
+# NOTE: zlib, used to decompress gzip input, is linked where it is a system library
+AK_ZLIB = sys.platform != 'win32'
+
 ak_extension = Extension(
         name='arraykit._arraykit', # build into module
         sources=['src/_arraykit.c'],
         include_dirs=get_ext_dir('numpy', 'core', 'include'),
         library_dirs=get_ext_dir('numpy', 'core', 'lib'),
-        define_macros=[("AK_VERSION", AK_VERSION)],
-        libraries=['npymath'], # not including mlib at this time
+        define_macros=[("AK_VERSION", AK_VERSION)] + ([("AK_ZLIB", None)] if AK_ZLIB else []),
+        libraries=['npymath'] + (['z'] if AK_ZLIB else []), # not including mlib at this time
         )
 
 setup(
@@ -21,6 +21,8 @@ from ._arraykit import resolve_dtype_iter as resolve_dtype_iter
 from ._arraykit import isna_element as isna_element
 from ._arraykit import dtype_from_element as dtype_from_element
 from ._arraykit import delimited_to_arrays as delimited_to_arrays
+from ._arraykit import iter_delimited_to_arrays as iter_delimited_to_arrays
+from ._arraykit import delimited_infer_schema as delimited_infer_schema
 from ._arraykit import iterable_str_to_array_1d as iterable_str_to_array_1d
 from ._arraykit import get_new_indexers_and_screen as get_new_indexers_and_screen
 from ._arraykit import split_after_count as split_after_count
@@ -1,5 +1,6 @@
 import typing as tp
 import datetime
+import mmap
 
 import numpy as np  # type: ignore
 
@@ -26,6 +27,17 @@ _TLabel = tp.Union[
         tp.Tuple['_TLabel'],
 ]
 
+_TRowTest = tp.Union[
+        str,
+        tp.AbstractSet[str],
+        tp.Tuple[tp.Optional[float], tp.Optional[float]],
+]
+_TRowFilter = tp.Union[
+        tp.Tuple[int, _TRowTest],
+        tp.List[tp.Tuple[int, _TRowTest]],
+        None,
+]
+
 class ErrorInitTypeBlocks(RuntimeError):
     def __init__(self, *args: tp.Any, **kwargs: tp.Any) -> None: ...
     def with_traceback(self, tb: Exception) -> Exception: ...
@@ -109,14 +121,22 @@ def iterable_str_to_array_1d(
         dtype: tp.Optional[tp.Any] = None,
         thousandschar: str = ',',
         decimalchar: str = '.',
+        na_values: tp.Optional[tp.Iterable[str]] = None,
         ) -> np.ndarray: ...
 
 def delimited_to_arrays(
-        file_like: tp.Iterable[str],
+        file_like: tp.Union[tp.Iterable[str], bytes, bytearray, memoryview, mmap.mmap, tp.BinaryIO],
         *,
         axis: int = 0,
-        dtypes: tp.Optional[tp.Callable[[int], tp.Any]] = None,
-        line_select: tp.Optional[tp.Callable[[int], bool]] = None,
+        dtypes: tp.Union[tp.Callable[[int], tp.Any], tp.Sequence[tp.Any], tp.Mapping[int, tp.Any], None] = None,
+        line_select: tp.Union[tp.Callable[[int], bool], tp.Sequence[int], tp.Sequence[bool], np.ndarray, None] = None,
+        row_filter: _TRowFilter = None,
+        categorical: tp.Union[bool, tp.Callable[[int], bool], tp.Sequence[int], tp.Sequence[bool], np.ndarray, None] = None,
+        narrow_int: bool = False,
+        narrow_float: bool = False,
+        na_values: tp.Optional[tp.Iterable[str]] = None,
+        skiprows: int = 0,
+        nrows: tp.Optional[int] = None,
         delimiter: str = ',',
         doublequote: bool = True,
         escapechar: tp.Optional[str] = '',
@@ -126,8 +146,58 @@ def delimited_to_arrays(
         strict: bool = False,
         thousandschar: str = ',',
         decimalchar: str = '.',
+        threads: int = 1,
+        preallocate: bool = False,
         ) -> tp.List[np.array]: ...
 
+def iter_delimited_to_arrays(
+        file_like: tp.Union[tp.Iterable[str], bytes, bytearray, memoryview, mmap.mmap, tp.BinaryIO],
+        *,
+        chunk_records: int,
+        axis: int = 0,
+        dtypes: tp.Union[tp.Callable[[int], tp.Any], tp.Sequence[tp.Any], tp.Mapping[int, tp.Any], None] = None,
+        line_select: tp.Union[tp.Callable[[int], bool], tp.Sequence[int], tp.Sequence[bool], np.ndarray, None] = None,
+        row_filter: _TRowFilter = None,
+        categorical: tp.Union[bool, tp.Callable[[int], bool], tp.Sequence[int], tp.Sequence[bool], np.ndarray, None] = None,
+        narrow_int: bool = False,
+        narrow_float: bool = False,
+        na_values: tp.Optional[tp.Iterable[str]] = None,
+        skiprows: int = 0,
+        nrows: tp.Optional[int] = None,
+        delimiter: str = ',',
+        doublequote: bool = True,
+        escapechar: tp.Optional[str] = '',
+        quotechar: tp.Optional[str] = '"',
+        quoting: int = 0,
+        skipinitialspace: bool = False,
+        strict: bool = False,
+        thousandschar: str = ',',
+        decimalchar: str = '.',
+        threads: int = 1,
+        ) -> tp.Iterator[tp.List[np.array]]: ...
+
+def delimited_infer_schema(
+        file_like: tp.Union[tp.Iterable[str], bytes, bytearray, memoryview, mmap.mmap, tp.BinaryIO],
+        *,
+        dtypes: tp.Union[tp.Callable[[int], tp.Any], tp.Sequence[tp.Any], tp.Mapping[int, tp.Any], None] = None,
+        line_select: tp.Union[tp.Callable[[int], bool], tp.Sequence[int], tp.Sequence[bool], np.ndarray, None] = None,
+        row_filter: _TRowFilter = None,
+        narrow_int: bool = False,
+        narrow_float: bool = False,
+        na_values: tp.Optional[tp.Iterable[str]] = None,
+        skiprows: int = 0,
+        nrows: tp.Optional[int] = None,
+        delimiter: str = ',',
+        doublequote: bool = True,
+        escapechar: tp.Optional[str] = '',
+        quotechar: tp.Optional[str] = '"',
+        quoting: int = 0,
+        skipinitialspace: bool = False,
+        strict: bool = False,
+        thousandschar: str = ',',
+        decimalchar: str = '.',
+        ) -> tp.Tuple[tp.List[np.dtype], int]: ...
+
 def split_after_count(
         string: str,
         *,
@@ -3,6 +3,9 @@
 # include "structmember.h"
 # include "stdbool.h"
 # include "limits.h"
+# ifdef AK_ZLIB
+# include "zlib.h"
+# endif
 
 # define PY_ARRAY_UNIQUE_SYMBOL AK_ARRAY_API
 # define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
@@ -84,6 +87,19 @@ const static size_t UCS4_SIZE = sizeof(Py_UCS4);
 # define AK_UNLIKELY(X) (!!(X))
 # endif
 
+// SSE2 is available on all x86-64 targets; AVX2 is only used if enabled at compile time.
+# if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+# define AK_SSE2 1
+# include <emmintrin.h>
+# endif
+# if defined __AVX2__
+# define AK_AVX2 1
+# include <immintrin.h>
+# endif
+# if defined _MSC_VER
+# include <intrin.h>
+# endif
+
 //------------------------------------------------------------------------------
 // C-level utility functions
 //------------------------------------------------------------------------------
@@ -355,6 +371,145 @@ AK_set_char(const char *name,
     return 0;
 }
 
+// Set a non-negative count from `src` on `target`; if src is NULL or None, use default. Returns -1 on error, else 0.
+static int
+AK_set_count(const char *name,
+        Py_ssize_t *target,
+        PyObject *src,
+        Py_ssize_t dflt)
+{
+    if (src == NULL || src == Py_None) {
+        *target = dflt;
+        return 0;
+    }
+    *target = PyNumber_AsSsize_t(src, PyExc_OverflowError);
+    if (*target == -1 && PyErr_Occurred()) return -1;
+    if (*target < 0) {
+        PyErr_Format(PyExc_ValueError, "\"%s\" must be non-negative", name);
+        return -1;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Threads
+
+// An AK_Parallel coordinates calling `func` once for each index in the range of `count`, handing out indices to threads as each becomes available.
+typedef struct AK_Parallel {
+    PyThread_type_lock lock; // guards next
+    Py_ssize_t next;
+    Py_ssize_t count;
+    void (*func)(void *context, Py_ssize_t i);
+    void *context;
+} AK_Parallel;
+
+typedef struct AK_ParallelWorker {
+    AK_Parallel *parallel;
+    PyThread_type_lock done; // held until the worker is finished
+} AK_ParallelWorker;
+
+// Process indices until there are none left. Cannot error.
+static void
+AK_Parallel_run(AK_Parallel *parallel)
+{
+    Py_ssize_t i;
+    while (true) {
+        PyThread_acquire_lock(parallel->lock, WAIT_LOCK);
+        i = parallel->next++;
+        PyThread_release_lock(parallel->lock);
+        if (i >= parallel->count) break;
+        parallel->func(parallel->context, i);
+    }
+}
+
+static void
+AK_Parallel_worker(void *arg)
+{
+    AK_ParallelWorker *worker = (AK_ParallelWorker*)arg;
+    AK_Parallel_run(worker->parallel);
+    PyThread_release_lock(worker->done);
+}
+
+// Call `func(context, i)` for each `i` in the range of `count` on up to `threads` threads, including the calling thread; returns when all calls have completed. `func` must not use the Python C-API; this function does not require the GIL, and callers should release it. If threads or locks cannot be created, fewer threads (or only the calling thread) are used. Cannot error.
+static void
+AK_ParallelFor(Py_ssize_t count,
+        int threads,
+        void (*func)(void *context, Py_ssize_t i),
+        void *context)
+{
+    AK_Parallel parallel = {NULL, 0, count, func, context};
+    AK_ParallelWorker *workers = NULL;
+    Py_ssize_t worker_count = 0;
+
+    if (threads > count) {
+        threads = (int)count;
+    }
+    if (threads > 1) {
+        parallel.lock = PyThread_allocate_lock();
+        workers = (AK_ParallelWorker*)PyMem_RawMalloc(
+                sizeof(AK_ParallelWorker) * (threads - 1));
+    }
+    if (parallel.lock == NULL || workers == NULL) {
+        // run on the calling thread
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            func(context, i);
+        }
+        if (parallel.lock != NULL) PyThread_free_lock(parallel.lock);
+        PyMem_RawFree(workers);
+        return;
+    }
+    for (int t = 0; t < threads - 1; ++t) {
+        AK_ParallelWorker *worker = workers + worker_count;
+        worker->parallel = &parallel;
+        worker->done = PyThread_allocate_lock();
+        if (worker->done == NULL) break;
+        PyThread_acquire_lock(worker->done, WAIT_LOCK);
+        if (PyThread_start_new_thread(AK_Parallel_worker, worker) == PYTHREAD_INVALID_THREAD_ID) {
+            PyThread_release_lock(worker->done);
+            PyThread_free_lock(worker->done);
+            break;
+        }
+        ++worker_count;
+    }
+    AK_Parallel_run(&parallel);
+
+    // wait for each worker to release its done lock
+    for (Py_ssize_t t = 0; t < worker_count; ++t) {
+        PyThread_acquire_lock(workers[t].done, WAIT_LOCK);
+        PyThread_release_lock(workers[t].done);
+        PyThread_free_lock(workers[t].done);
+    }
+    PyThread_free_lock(parallel.lock);
+    PyMem_RawFree(workers);
+}
+
+//------------------------------------------------------------------------------
+// Datetime utilities
+
+static inline int
+AK_days_in_month(npy_int64 year, int month)
+{
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+// Return the metadata of a datetime64 dtype.
+static inline PyArray_DatetimeMetaData*
+AK_datetime_meta(PyArray_Descr* dtype)
+{
+    return &(((PyArray_DatetimeDTypeMetaData*)dtype->c_metadata)->meta);
+}
+
+// Return true if `dtype` is a datetime64 dtype without a unit.
+static inline bool
+AK_dtype_generic_datetime(PyArray_Descr* dtype)
+{
+    return dtype != NULL && dtype->kind == 'M' && AK_datetime_meta(dtype)->base == NPY_FR_GENERIC;
+}
+
 //------------------------------------------------------------------------------
 // TypeParser: Type, New, Destructor
 
@@ -366,7 +521,8 @@ typedef enum AK_TypeParserState {
     TPS_FLOAT,
     TPS_COMPLEX, // 4
     TPS_STRING,
-    TPS_EMPTY // empty fields
+    TPS_EMPTY, // empty fields
+    TPS_DATETIME, // ISO 8601 dates and times
 } AK_TypeParserState;
 
 // Given previous and new parser states, return a next parser state. Does not error.
@@ -381,6 +537,11 @@ AK_TPS_Resolve(AK_TypeParserState previous, AK_TypeParserState new) {
     // if either are string, go to string
     if (previous == TPS_STRING || new == TPS_STRING) return TPS_STRING;
 
+    // datetimes only resolve with datetimes or empty fields
+    if (previous == TPS_DATETIME || new == TPS_DATETIME) {
+        return (previous == new || new == TPS_EMPTY) ? TPS_DATETIME : TPS_STRING;
+    }
+
     // handle both new, previous bool directly
     if (previous == TPS_BOOL) {
         if (new == TPS_EMPTY || new == TPS_BOOL) return TPS_BOOL;
@@ -431,6 +592,9 @@ AK_TPS_ToDtype(AK_TypeParserState state) {
         case TPS_COMPLEX:
             dtype = PyArray_DescrNewFromType(NPY_COMPLEX128);
             break;
+        case TPS_DATETIME: // a generic unit, to be set from the values
+            dtype = PyArray_DescrNewFromType(NPY_DATETIME);
+            break;
     }
     if (dtype == NULL) return NULL; // assume error is set by PyArray_DescrFromType
     return dtype;
@@ -461,6 +625,26 @@ typedef struct AK_TypeParser {
     AK_TypeParserState parsed_field; // state of current field
     AK_TypeParserState parsed_line; // state of current resolved line type
 
+    // position matched in the datetime forms of AK_TP_datetime_char, or -1 if not a datetime
+    Py_ssize_t dt_pos;
+    npy_int64 dt_value; // the component being read
+    npy_int64 dt_year;
+    int dt_month;
+    int field_dt_unit; // set when the field resolves to TPS_DATETIME
+    int line_dt_unit; // finest unit of datetime fields in the line, or -1
+
+    // magnitude of the digits of the current field, for selecting narrower dtypes
+    npy_uint64 field_magnitude;
+    bool field_negative;
+    bool field_overflow; // the magnitude exceeds a uint64
+    // bounds of int and float fields in the line, for selecting narrower dtypes
+    npy_uint64 line_max; // largest non-negative int
+    npy_uint64 line_min_magnitude; // magnitude of the smallest negative int
+    bool line_overflow;
+    Py_ssize_t line_digits; // most digits in an int or float field
+    bool line_e; // a float field has an exponent
+    bool line_na; // a field matched an NA value; set by the CPL
+
     Py_UCS4 tsep;
     Py_UCS4 decc;
 
@@ -489,16 +673,35 @@ void AK_TP_reset_field(AK_TypeParser* tp)
     tp->count_not_space = 0;
 
     tp->parsed_field = TPS_UNKNOWN;
+    tp->field_magnitude = 0;
+    tp->field_negative = false;
+    tp->field_overflow = false;
+    tp->dt_pos = 0;
+    tp->dt_value = 0;
     // NOTE: do not reset parsed_line
 }
 
+// Initialize the state of the line; called before the first field of a line.
+void AK_TP_reset_line(AK_TypeParser* tp)
+{
+    tp->parsed_line = TPS_UNKNOWN;
+    tp->line_max = 0;
+    tp->line_min_magnitude = 0;
+    tp->line_overflow = false;
+    tp->line_digits = 0;
+    tp->line_e = false;
+    tp->line_dt_unit = -1;
+    tp->line_na = false;
+}
+
+// Returns NULL on memory failure without setting an exception; as type parsers are created while tokenizing, this must be callable without the GIL.
 AK_TypeParser*
 AK_TP_New(Py_UCS4 tsep, Py_UCS4 decc)
 {
-    AK_TypeParser *tp = (AK_TypeParser*)PyMem_Malloc(sizeof(AK_TypeParser));
-    if (tp == NULL) return (AK_TypeParser*)PyErr_NoMemory();
+    AK_TypeParser *tp = (AK_TypeParser*)PyMem_RawMalloc(sizeof(AK_TypeParser));
+    if (tp == NULL) return NULL;
     AK_TP_reset_field(tp);
-    tp->parsed_line = TPS_UNKNOWN;
+    AK_TP_reset_line(tp);
     tp->tsep = tsep; // take tsep into context for auto eval?
     tp->decc = decc;
     return tp;
@@ -507,21 +710,90 @@ AK_TP_New(Py_UCS4 tsep, Py_UCS4 decc)
 void
 AK_TP_Free(AK_TypeParser* tp)
 {
-    PyMem_Free(tp);
+    PyMem_RawFree(tp);
 }
 
 //------------------------------------------------------------------------------
 
-// Given a type parse, process a single character and update the type parser state in `parsed_field`. Return true when processing should continue, false when no further processing is necessary. `pos` is the raw position within the current field.
-bool
-AK_TP_ProcessChar(AK_TypeParser* tp,
+// Validate the datetime component ending at dt_pos from dt_value, then clear dt_value. Returns false if the component is out of range.
+static inline bool
+AK_TP_datetime_close(AK_TypeParser* tp)
+{
+    npy_int64 v = tp->dt_value;
+    tp->dt_value = 0;
+    switch (tp->dt_pos) {
+        case 4:
+            tp->dt_year = v;
+            return true;
+        case 7:
+            tp->dt_month = (int)v;
+            return 1 <= v && v <= 12;
+        case 10:
+            return 1 <= v && v <= AK_days_in_month(tp->dt_year, tp->dt_month);
+        case 13:
+            return v <= 23;
+        case 16:
+        case 19:
+            return v <= 59;
+    }
+    return tp->dt_pos >= 21; // a fraction of at least one digit
+}
+
+// Match a character against the datetime forms YYYY-MM-DD[(T| )hh[:mm[:ss[.f{1,9}]]]], skipping leading space. Sets dt_pos to -1 once the field cannot be a datetime.
+static inline void
+AK_TP_datetime_char(AK_TypeParser* tp, Py_UCS4 c)
+{
+    Py_ssize_t p = tp->dt_pos;
+    bool valid;
+    switch (p) {
+        case 0:
+            if (AK_is_space(c)) return;
+            valid = AK_is_digit(c);
+            break;
+        case 4:
+        case 7:
+            valid = c == '-' && AK_TP_datetime_close(tp);
+            break;
+        case 10:
+            valid = (c == 'T' || c == ' ') && AK_TP_datetime_close(tp);
+            break;
+        case 13:
+        case 16:
+            valid = c == ':' && AK_TP_datetime_close(tp);
+            break;
+        case 19:
+            valid = c == '.' && AK_TP_datetime_close(tp);
+            break;
+        default:
+            valid = p < 29 && AK_is_digit(c);
+    }
+    if (valid && AK_is_digit(c)) {
+        tp->dt_value = tp->dt_value * 10 + (c - '0');
+    }
+    tp->dt_pos = valid ? p + 1 : -1;
+}
+
+// Return the datetime unit of a field fully matched by AK_TP_datetime_char, or -1 if the field is not a datetime. As a year and month (YYYY-MM) is as likely a label as a date, only fields with at least a full date are datetimes.
+static int
+AK_TP_datetime_unit(AK_TypeParser* tp)
+{
+    Py_ssize_t p = tp->dt_pos;
+    if (p < 10 || !AK_TP_datetime_close(tp)) return -1;
+    switch (p) {
+        case 10: return NPY_FR_D;
+        case 13: return NPY_FR_h;
+        case 16: return NPY_FR_m;
+        case 19: return NPY_FR_s;
+    }
+    return p <= 23 ? NPY_FR_ms : p <= 26 ? NPY_FR_us : NPY_FR_ns;
+}
+
+// Process a character for all types other than datetimes; see AK_TP_ProcessChar.
+static bool
+AK_TP_process_char(AK_TypeParser* tp,
         Py_UCS4 c,
         Py_ssize_t pos)
 {
-    if (tp->parsed_field != TPS_UNKNOWN) {
-        // if parsed_field is set to anything other than TPS_UNKNOWN, we should not be calling process_char anymore
-        Py_UNREACHABLE();
-    }
 
     // evaluate space ..........................................................
     bool space = false;
@@ -578,6 +850,13 @@ AK_TP_ProcessChar(AK_TypeParser* tp,
         ++tp->count_digit;
         digit = true;
         numeric = true;
+        npy_uint64 d = (npy_uint64)(c - '0');
+        if (tp->field_magnitude > (NPY_MAX_UINT64 - d) / 10) {
+            tp->field_overflow = true;
+        }
+        else {
+            tp->field_magnitude = tp->field_magnitude * 10 + d;
+        }
     }
     else if (c == tp->decc) { // is decimal
         ++tp->count_decimal;
@@ -594,6 +873,7 @@ AK_TP_ProcessChar(AK_TypeParser* tp,
             return false;
         }
         tp->last_sign_pos = pos_field;
+        if (c == '-') tp->field_negative = true;
         numeric = true;
     }
     else if (AK_is_e(c)) {
@@ -701,6 +981,23 @@ AK_TP_ProcessChar(AK_TypeParser* tp,
     return true; // continue processing
 }
 
+// Given a type parse, process a single character and update the type parser state in `parsed_field`. Return true when processing should continue, false when no further processing is necessary. `pos` is the raw position within the current field. As datetimes are matched separately, processing continues while the field might be a datetime, even if parsed_field is determined.
+bool
+AK_TP_ProcessChar(AK_TypeParser* tp,
+        Py_UCS4 c,
+        Py_ssize_t pos)
+{
+    bool active = false;
+    if (tp->parsed_field == TPS_UNKNOWN) {
+        active = AK_TP_process_char(tp, c, pos);
+    }
+    if (tp->dt_pos >= 0) {
+        AK_TP_datetime_char(tp, c);
+        active |= tp->dt_pos >= 0;
+    }
+    return active;
+}
+
 // This private function is used by AK_TP_ResolveLineResetField to evaluate the state of the AK_TypeParser and determine the resolved AK_TypeParserState.
 AK_TypeParserState
 AK_TP_resolve_field(AK_TypeParser* tp,
@@ -708,6 +1005,14 @@ AK_TP_resolve_field(AK_TypeParser* tp,
 {
     if (count == 0) return TPS_EMPTY;
 
+    if (tp->dt_pos >= 10) {
+        int unit = AK_TP_datetime_unit(tp);
+        if (unit >= 0) {
+            tp->field_dt_unit = unit;
+            return TPS_DATETIME;
+        }
+    }
+
     // if parsed_field is known, return it
     if (tp->parsed_field != TPS_UNKNOWN) return tp->parsed_field;
 
@@ -815,16 +1120,97 @@ AK_TP_ResolveLineResetField(AK_TypeParser* tp,
         Py_ssize_t count)
 {
     if (tp->parsed_line != TPS_STRING) {
+        AK_TypeParserState parsed_field = AK_TP_resolve_field(tp, count);
+        if (parsed_field == TPS_INT || parsed_field == TPS_FLOAT) {
+            if (tp->count_digit > tp->line_digits) tp->line_digits = tp->count_digit;
+            if (tp->count_e > 0) tp->line_e = true;
+        }
+        if (parsed_field == TPS_DATETIME && tp->field_dt_unit > tp->line_dt_unit) {
+            tp->line_dt_unit = tp->field_dt_unit;
+        }
+        if (parsed_field == TPS_INT) {
+            if (tp->field_overflow) {
+                tp->line_overflow = true;
+            }
+            else if (tp->field_negative) {
+                if (tp->field_magnitude > tp->line_min_magnitude) {
+                    tp->line_min_magnitude = tp->field_magnitude;
+                }
+            }
+            else if (tp->field_magnitude > tp->line_max) {
+                tp->line_max = tp->field_magnitude;
+            }
+        }
         // resolve with previous parsed_line (or unkown if just initialized)
-        tp->parsed_line = AK_TPS_Resolve(tp->parsed_line, AK_TP_resolve_field(tp, count));
+        tp->parsed_line = AK_TPS_Resolve(tp->parsed_line, parsed_field);
     }
     AK_TP_reset_field(tp);
     // if string, return false to stop further line processing
     return tp->parsed_line != TPS_STRING;
 }
 
+// Combine the resolved line state of `other` into `tp`, as if the fields resolved by `other` had been resolved by `tp`. Cannot error.
+static void
+AK_TP_ExtendLine(AK_TypeParser* tp, const AK_TypeParser* other)
+{
+    tp->parsed_line = AK_TPS_Resolve(tp->parsed_line, other->parsed_line);
+    if (other->line_max > tp->line_max) tp->line_max = other->line_max;
+    if (other->line_min_magnitude > tp->line_min_magnitude) {
+        tp->line_min_magnitude = other->line_min_magnitude;
+    }
+    if (other->line_digits > tp->line_digits) tp->line_digits = other->line_digits;
+    if (other->line_dt_unit > tp->line_dt_unit) tp->line_dt_unit = other->line_dt_unit;
+    tp->line_overflow |= other->line_overflow;
+    tp->line_e |= other->line_e;
+    tp->line_na |= other->line_na;
+}
+
+// Return a fresh dtype for the resolved line as AK_TPS_ToDtype does, except: datetimes are given the finest unit found; int lines, and lines of only empty fields, with NA values are given a float dtype to hold NaN; bool lines with NA values, which bool cannot represent, are given a str dtype; if `narrow_int`, an int line is given the smallest signed integer dtype that holds all values, or uint64 for non-negative values beyond int64; if `narrow_float`, a float line is given float32 if all fields have no exponent and at most six digits, such that each is the nearest float32 to a unique decimal value. Returns NULL on error.
+PyArray_Descr*
+AK_TP_ToDtype(AK_TypeParser* tp, bool narrow_int, bool narrow_float)
+{
+    AK_TypeParserState parsed_line = tp->parsed_line;
+    if (tp->line_na && (parsed_line == TPS_INT || parsed_line == TPS_EMPTY)) {
+        parsed_line = TPS_FLOAT;
+    }
+    else if (tp->line_na && parsed_line == TPS_BOOL) {
+        parsed_line = TPS_STRING;
+    }
+    if (parsed_line == TPS_INT && narrow_int && !tp->line_overflow) {
+        npy_uint64 pos = tp->line_max;
+        npy_uint64 neg = tp->line_min_magnitude;
+        int type_num = NPY_INT64;
+        if (pos <= NPY_MAX_INT8 && neg <= (npy_uint64)NPY_MAX_INT8 + 1) {
+            type_num = NPY_INT8;
+        }
+        else if (pos <= NPY_MAX_INT16 && neg <= (npy_uint64)NPY_MAX_INT16 + 1) {
+            type_num = NPY_INT16;
+        }
+        else if (pos <= NPY_MAX_INT32 && neg <= (npy_uint64)NPY_MAX_INT32 + 1) {
+            type_num = NPY_INT32;
+        }
+        else if (pos > NPY_MAX_INT64 && neg == 0) {
+            type_num = NPY_UINT64;
+        }
+        return PyArray_DescrNewFromType(type_num);
+    }
+    if (parsed_line == TPS_FLOAT && narrow_float
+            && !tp->line_e
+            && tp->line_digits <= 6) { // FLT_DIG
+        return PyArray_DescrNewFromType(NPY_FLOAT32);
+    }
+    PyArray_Descr *dtype = AK_TPS_ToDtype(parsed_line);
+    if (dtype != NULL && parsed_line == TPS_DATETIME && tp->line_dt_unit >= 0) {
+        AK_datetime_meta(dtype)->base = (NPY_DATETIMEUNIT)tp->line_dt_unit;
+        AK_datetime_meta(dtype)->num = 1;
+    }
+    return dtype;
+}
+
 //------------------------------------------------------------------------------
-// UCS4 array processors
+// UCS1 array processors
+
+// NOTE: numeric processors read 1-byte (Latin-1) code points: as none of these processors accept characters beyond ASCII, a CodePointLine with wider code points can never be converted to a number.
 
 static char* TRUE_LOWER = "true";
 static char* TRUE_UPPER = "TRUE";
@@ -833,9 +1219,9 @@ static char* TRUE_UPPER = "TRUE";
 #define ERROR_OVERFLOW 2
 #define ERROR_INVALID_CHARS 3
 
-// Convert a Py_UCS4 array to a signed integer. Extended from pandas/_libs/src/parser/tokenizer.c. Sets `error` to values greater than 0 on error; never sets error on success.
+// Convert a Py_UCS1 array to a signed integer. Extended from pandas/_libs/src/parser/tokenizer.c. Sets `error` to values greater than 0 on error; never sets error on success.
 static inline npy_int64
-AK_UCS4_to_int64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep)
+AK_UCS1_to_int64(Py_UCS1 *p_item, Py_UCS1 *end, int *error, char tsep)
 {
     npy_int64 int_min = NPY_MIN_INT64;
     npy_int64 int_max = NPY_MAX_INT64;
@@ -843,7 +1229,7 @@ AK_UCS4_to_int64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep)
     npy_int64 number = 0;
     int d;
 
-    Py_UCS4 *p = p_item;
+    Py_UCS1 *p = p_item;
 
     while (AK_is_space(*p)) {
         ++p;
@@ -953,16 +1339,16 @@ AK_UCS4_to_int64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep)
     return number;
 }
 
-// Convert a Py_UCS4 array to an unsigned integer. Extended from pandas/_libs/src/parser/tokenizer.c. Sets error to > 0 on error; never sets error on success.
+// Convert a Py_UCS1 array to an unsigned integer. Extended from pandas/_libs/src/parser/tokenizer.c. Sets error to > 0 on error; never sets error on success.
 static inline npy_uint64
-AK_UCS4_to_uint64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep)
+AK_UCS1_to_uint64(Py_UCS1 *p_item, Py_UCS1 *end, int *error, char tsep)
 {
     npy_uint64 pre_max = NPY_MAX_UINT64 / 10;
     npy_uint64 number = 0;
     int dig_pre_max = NPY_MAX_UINT64 % 10;
     int d;
 
-    Py_UCS4 *p = p_item;
+    Py_UCS1 *p = p_item;
     while (AK_is_space(*p)) {
         ++p;
         if (p >= end) return number;
@@ -1027,54 +1413,884 @@ AK_UCS4_to_uint64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep)
     return number;
 }
 
-// Based on precise_xstrtod from pandas/_libs/src/parser/tokenizer.c.
+// Truncated 128-bit approximations of powers of five from 5^-342 to 5^308, normalized such that the most significant bit is set, stored as pairs of high and low 64-bit words. Used by AK_float64_eisel_lemire.
+# define AK_POW5_MIN -342
+# define AK_POW5_MAX 308
+static const npy_uint64 AK_pow5_128[] = {
+    0xeef453d6923bd65a, 0x113faa2906a13b3f,
+    0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+    0xbaaee17fa23ebf76, 0x5d79bcf00d2df649,
+    0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+    0x91d8a02bb6c10594, 0x79071b9b8a4be869,
+    0xb64ec836a47146f9, 0x9748e2826cdee284,
+    0xe3e27a444d8d98b7, 0xfd1b1b2308169b25,
+    0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+    0xb208ef855c969f4f, 0xbdbd2d335e51a935,
+    0xde8b2b66b3bc4723, 0xad2c788035e61382,
+    0x8b16fb203055ac76, 0x4c3bcb5021afcc31,
+    0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+    0xd953e8624b85dd78, 0xd71d6dad34a2af0d,
+    0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+    0xa9c98d8ccb009506, 0x680efdaf511f18c2,
+    0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+    0x84a57695fe98746d, 0x014bb630f7604b57,
+    0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+    0xcf42894a5dce35ea, 0x52064cac828675b9,
+    0x818995ce7aa0e1b2, 0x7343efebd1940993,
+    0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8,
+    0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+    0xfd00b897478238d0, 0x8920b098955522b4,
+    0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+    0xc5a890362fddbc62, 0xeb2189f734aa831d,
+    0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+    0x9a6bb0aa55653b2d, 0x47b233c92125366e,
+    0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+    0xf148440a256e2c76, 0xc00670ea43ca250d,
+    0x96cd2a865764dbca, 0x380406926a5e5728,
+    0xbc807527ed3e12bc, 0xc605083704f5ecf2,
+    0xeba09271e88d976b, 0xf7864a44c633682e,
+    0x93445b8731587ea3, 0x7ab3ee6afbe0211d,
+    0xb8157268fdae9e4c, 0x5960ea05bad82964,
+    0xe61acf033d1a45df, 0x6fb92487298e33bd,
+    0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+    0xb3c4f1ba87bc8696, 0x8f48a4899877186c,
+    0xe0b62e2929aba83c, 0x331acdabfe94de87,
+    0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14,
+    0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+    0xdb71e91432b1a24a, 0xc9e82cd9f69d6150,
+    0x892731ac9faf056e, 0xbe311c083a225cd2,
+    0xab70fe17c79ac6ca, 0x6dbd630a48aaf406,
+    0xd64d3d9db981787d, 0x092cbbccdad5b108,
+    0x85f0468293f0eb4e, 0x25bbf56008c58ea5,
+    0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+    0xd1476e2c07286faa, 0x1af5af660db4aee1,
+    0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+    0xa37fce126597973c, 0xe50ff107bab528a0,
+    0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+    0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a,
+    0x9faacf3df73609b1, 0x77b191618c54e9ac,
+    0xc795830d75038c1d, 0xd59df5b9ef6a2417,
+    0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+    0x9becce62836ac577, 0x4ee367f9430aec32,
+    0xc2e801fb244576d5, 0x229c41f793cda73f,
+    0xf3a20279ed56d48a, 0x6b43527578c1110f,
+    0x9845418c345644d6, 0x830a13896b78aaa9,
+    0xbe5691ef416bd60c, 0x23cc986bc656d553,
+    0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+    0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9,
+    0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+    0xe858ad248f5c22c9, 0xd1b3400f8f9cff68,
+    0x91376c36d99995be, 0x23100809b9c21fa1,
+    0xb58547448ffffb2d, 0xabd40a0c2832a78a,
+    0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+    0x8dd01fad907ffc3b, 0xae3da7d97f6792e3,
+    0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+    0xdd95317f31c7fa1d, 0x40405643d711d583,
+    0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+    0xad1c8eab5ee43b66, 0xda3243650005eecf,
+    0xd863b256369d4a40, 0x90bed43e40076a82,
+    0x873e4f75e2224e68, 0x5a7744a6e804a291,
+    0xa90de3535aaae202, 0x711515d0a205cb36,
+    0xd3515c2831559a83, 0x0d5a5b44ca873e03,
+    0x8412d9991ed58091, 0xe858790afe9486c2,
+    0xa5178fff668ae0b6, 0x626e974dbe39a872,
+    0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+    0x80fa687f881c7f8e, 0x7ce66634bc9d0b99,
+    0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+    0xc987434744ac874e, 0xa327ffb266b56220,
+    0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+    0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9,
+    0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+    0xf6019da07f549b2b, 0x7e2a53a146606a48,
+    0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+    0xc0314325637a1939, 0xfa911155fefb5308,
+    0xf03d93eebc589f88, 0x793555ab7eba27ca,
+    0x96267c7535b763b5, 0x4bc1558b2f3458de,
+    0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+    0xea9c227723ee8bcb, 0x465e15a979c1cadc,
+    0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+    0xb749faed14125d36, 0xcef980ec671f667b,
+    0xe51c79a85916f484, 0x82b7e12780e7401a,
+    0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810,
+    0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+    0xdfbdcece67006ac9, 0x67a791e093e1d49a,
+    0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+    0xaecc49914078536d, 0x58fae9f773886e18,
+    0xda7f5bf590966848, 0xaf39a475506a899e,
+    0x888f99797a5e012d, 0x6d8406c952429603,
+    0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+    0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64,
+    0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+    0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e,
+    0xd0601d8efc57b08b, 0xf13b94daf124da26,
+    0x823c12795db6ce57, 0x76c53d08d6b70858,
+    0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+    0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09,
+    0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+    0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf,
+    0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+    0xf867241c8cc6d4c0, 0xc30163d203c94b62,
+    0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+    0xc21094364dfb5636, 0x985915fc12f542e4,
+    0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+    0x979cf3ca6cec5b5a, 0xa705992ceecf9c42,
+    0xbd8430bd08277231, 0x50c6ff782a838353,
+    0xece53cec4a314ebd, 0xa4f8bf5635246428,
+    0x940f4613ae5ed136, 0x871b7795e136be99,
+    0xb913179899f68584, 0x28e2557b59846e3f,
+    0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+    0x9096ea6f3848984f, 0x3ff0d2c85def7621,
+    0xb4bca50b065abe63, 0x0fed077a756b53a9,
+    0xe1ebce4dc7f16dfb, 0xd3e8495912c62894,
+    0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+    0xb080392cc4349dec, 0xbd8d794d96aacfb3,
+    0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+    0x89e42caaf9491b60, 0xf41686c49db57244,
+    0xac5d37d5b79b6239, 0x311c2875c522ced5,
+    0xd77485cb25823ac7, 0x7d633293366b828b,
+    0x86a8d39ef77164bc, 0xae5dff9c02033197,
+    0xa8530886b54dbdeb, 0xd9f57f830283fdfc,
+    0xd267caa862a12d66, 0xd072df63c324fd7b,
+    0x8380dea93da4bc60, 0x4247cb9e59f71e6d,
+    0xa46116538d0deb78, 0x52d9be85f074e608,
+    0xcd795be870516656, 0x67902e276c921f8b,
+    0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+    0xa086cfcd97bf97f3, 0x80e8a40eccd228a4,
+    0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+    0xfad2a4b13d1b5d6c, 0x796b805720085f81,
+    0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+    0xc3f490aa77bd60fc, 0xbedbfc4411068a9c,
+    0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+    0x991711052d8bf3c5, 0x751bdd152d4d1c4a,
+    0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+    0xef340a98172aace4, 0x86fb897116c87c34,
+    0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+    0xbae0a846d2195712, 0x8974836059cca109,
+    0xe998d258869facd7, 0x2bd1a438703fc94b,
+    0x91ff83775423cc06, 0x7b6306a34627ddcf,
+    0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+    0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93,
+    0x8e938662882af53e, 0x547eb47b7282ee9c,
+    0xb23867fb2a35b28d, 0xe99e619a4f23aa43,
+    0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+    0x8b3c113c38f9f37e, 0xde83bc408dd3dd04,
+    0xae0b158b4738705e, 0x9624ab50b148d445,
+    0xd98ddaee19068c76, 0x3badd624dd9b0957,
+    0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+    0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c,
+    0xd47487cc8470652b, 0x7647c3200069671f,
+    0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073,
+    0xa5fb0a17c777cf09, 0xf468107100525890,
+    0xcf79cc9db955c2cc, 0x7182148d4066eeb4,
+    0x81ac1fe293d599bf, 0xc6f14cd848405530,
+    0xa21727db38cb002f, 0xb8ada00e5a506a7c,
+    0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+    0xfd442e4688bd304a, 0x908f4a166d1da663,
+    0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+    0xc5dd44271ad3cdba, 0x40eff1e1853f29fd,
+    0xf7549530e188c128, 0xd12bee59e68ef47c,
+    0x9a94dd3e8cf578b9, 0x82bb74f8301958ce,
+    0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+    0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1,
+    0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+    0xbcb2b812db11a5de, 0x7415d448f6b6f0e7,
+    0xebdf661791d60f56, 0x111b495b3464ad21,
+    0x936b9fcebb25c995, 0xcab10dd900beec34,
+    0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+    0xe65829b3046b0afa, 0x0cb4a5a3112a5112,
+    0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+    0xb3f4e093db73a093, 0x59ed216765690f56,
+    0xe0f218b8d25088b8, 0x306869c13ec3532c,
+    0x8c974f7383725573, 0x1e414218c73a13fb,
+    0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+    0xdbac6c247d62a583, 0xdf45f746b74abf39,
+    0x894bc396ce5da772, 0x6b8bba8c328eb783,
+    0xab9eb47c81f5114f, 0x066ea92f3f326564,
+    0xd686619ba27255a2, 0xc80a537b0efefebd,
+    0x8613fd0145877585, 0xbd06742ce95f5f36,
+    0xa798fc4196e952e7, 0x2c48113823b73704,
+    0xd17f3b51fca3a7a0, 0xf75a15862ca504c5,
+    0x82ef85133de648c4, 0x9a984d73dbe722fb,
+    0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba,
+    0xcc963fee10b7d1b3, 0x318df905079926a8,
+    0xffbbcfe994e5c61f, 0xfdf17746497f7052,
+    0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+    0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0,
+    0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+    0x9c1661a651213e2d, 0x06bea10ca65c084e,
+    0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+    0xf3e2f893dec3f126, 0x5a89dba3c3efccfa,
+    0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+    0xbe89523386091465, 0xf6bbb397f1135823,
+    0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+    0x94db483840b717ef, 0xa8c2a44eb4571cdc,
+    0xba121a4650e4ddeb, 0x92f34d62616ce413,
+    0xe896a0d7e51e1566, 0x77b020baf9c81d17,
+    0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+    0xb5b5ada8aaff80b8, 0x0d819992132456ba,
+    0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+    0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1,
+    0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+    0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde,
+    0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+    0xad4ab7112eb3929d, 0x86c16c98d2c953c6,
+    0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+    0x87625f056c7c4a8b, 0x11471cd764ad4972,
+    0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+    0xd389b47879823479, 0x4aff1d108d4ec2c3,
+    0x843610cb4bf160cb, 0xcedf722a585139ba,
+    0xa54394fe1eedb8fe, 0xc2974eb4ee658828,
+    0xce947a3da6a9273e, 0x733d226229feea32,
+    0x811ccc668829b887, 0x0806357d5a3f525f,
+    0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+    0xc9bcff6034c13052, 0xfc89b393dd02f0b5,
+    0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+    0x9d9ba7832936edc0, 0xd54b944b84aa4c0d,
+    0xc5029163f384a931, 0x0a9e795e65d4df11,
+    0xf64335bcf065d37d, 0x4d4617b5ff4a16d5,
+    0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+    0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6,
+    0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+    0x964e858c91ba2655, 0x3a6a07f8d510f86f,
+    0xbbe226efb628afea, 0x890489f70a55368b,
+    0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e,
+    0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+    0xb77ada0617e3bbcb, 0x09ce6ebb40173744,
+    0xe55990879ddcaabd, 0xcc420a6a101d0515,
+    0x8f57fa54c2a9eab6, 0x9fa946824a12232d,
+    0xb32df8e9f3546564, 0x47939822dc96abf9,
+    0xdff9772470297ebd, 0x59787e2b93bc56f7,
+    0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+    0xaefae51477a06b03, 0xede622920b6b23f1,
+    0xdab99e59958885c4, 0xe95fab368e45eced,
+    0x88b402f7fd75539b, 0x11dbcb0218ebb414,
+    0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+    0xd59944a37c0752a2, 0x4be76d3346f0495f,
+    0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+    0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952,
+    0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+    0x825ecc24c873782f, 0x8ed400668c0c28c8,
+    0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+    0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9,
+    0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+    0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9,
+    0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+    0xf8a95fcf88747d94, 0x75a44c6397ce912a,
+    0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+    0xc24452da229b021b, 0xfbe85badce996168,
+    0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+    0x97c560ba6b0919a5, 0xdccd879fc967d41a,
+    0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+    0xed246723473e3813, 0x290123e9aab23b68,
+    0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+    0xb94470938fa89bce, 0xf808e40e8d5b3e69,
+    0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+    0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2,
+    0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+    0xe2280b6c20dd5232, 0x25c6da63c38de1b0,
+    0x8d590723948a535f, 0x579c487e5a38ad0e,
+    0xb0af48ec79ace837, 0x2d835a9df0c6d851,
+    0xdcdb1b2798182244, 0xf8e431456cf88e65,
+    0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff,
+    0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+    0xd7adf884aa879177, 0x5b0ed81dcc6abb0f,
+    0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+    0xa87fea27a539e9a5, 0x3f2398d747b36224,
+    0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+    0x83a3eeeef9153e89, 0x1953cf68300424ac,
+    0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+    0xcdb02555653131b6, 0x3792f412cb06794d,
+    0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+    0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4,
+    0xc8de047564d20a8b, 0xf245825a5a445275,
+    0xfb158592be068d2e, 0xeed6e2f0f0d56712,
+    0x9ced737bb6c4183d, 0x55464dd69685606b,
+    0xc428d05aa4751e4c, 0xaa97e14c3c26b886,
+    0xf53304714d9265df, 0xd53dd99f4b3066a8,
+    0x993fe2c6d07b7fab, 0xe546a8038efe4029,
+    0xbf8fdb78849a5f96, 0xde98520472bdd033,
+    0xef73d256a5c0f77c, 0x963e66858f6d4440,
+    0x95a8637627989aad, 0xdde7001379a44aa8,
+    0xbb127c53b17ec159, 0x5560c018580d5d52,
+    0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+    0x9226712162ab070d, 0xcab3961304ca70e8,
+    0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+    0xe45c10c42a2b3b05, 0x8cb89a7db77c506a,
+    0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+    0xb267ed1940f1c61c, 0x55f038b237591ed3,
+    0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+    0x8b61313bbabce2c6, 0x2323ac4b3b3da015,
+    0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+    0xd9c7dced53c72255, 0x96e7bd358c904a21,
+    0x881cea14545c7575, 0x7e50d64177da2e54,
+    0xaa242499697392d2, 0xdde50bd1d5d0b9e9,
+    0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+    0x84ec3c97da624ab4, 0xbd5af13bef0b113e,
+    0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+    0xcfb11ead453994ba, 0x67de18eda5814af2,
+    0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+    0xa2425ff75e14fc31, 0xa1258379a94d028d,
+    0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+    0xfd87b5f28300ca0d, 0x8bca9d6e188853fc,
+    0x9e74d1b791e07e48, 0x775ea264cf55347e,
+    0xc612062576589dda, 0x95364afe032a819e,
+    0xf79687aed3eec551, 0x3a83ddbd83f52205,
+    0x9abe14cd44753b52, 0xc4926a9672793543,
+    0xc16d9a0095928a27, 0x75b7053c0f178294,
+    0xf1c90080baf72cb1, 0x5324c68b12dd6339,
+    0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+    0xbce5086492111aea, 0x88f4bb1ca6bcf585,
+    0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+    0x9392ee8e921d5d07, 0x3aff322e62439fd0,
+    0xb877aa3236a4b449, 0x09befeb9fad487c3,
+    0xe69594bec44de15b, 0x4c2ebe687989a9b4,
+    0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+    0xb424dc35095cd80f, 0x538484c19ef38c95,
+    0xe12e13424bb40e13, 0x2865a5f206b06fba,
+    0x8cbccc096f5088cb, 0xf93f87b7442e45d4,
+    0xafebff0bcb24aafe, 0xf78f69a51539d749,
+    0xdbe6fecebdedd5be, 0xb573440e5a884d1c,
+    0x89705f4136b4a597, 0x31680a88f8953031,
+    0xabcc77118461cefc, 0xfdc20d2b36ba7c3e,
+    0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+    0x8637bd05af6c69b5, 0xa63f9a49c2c1b110,
+    0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+    0xd1b71758e219652b, 0xd3c36113404ea4a9,
+    0x83126e978d4fdf3b, 0x645a1cac083126ea,
+    0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4,
+    0xcccccccccccccccc, 0xcccccccccccccccd,
+    0x8000000000000000, 0x0000000000000000,
+    0xa000000000000000, 0x0000000000000000,
+    0xc800000000000000, 0x0000000000000000,
+    0xfa00000000000000, 0x0000000000000000,
+    0x9c40000000000000, 0x0000000000000000,
+    0xc350000000000000, 0x0000000000000000,
+    0xf424000000000000, 0x0000000000000000,
+    0x9896800000000000, 0x0000000000000000,
+    0xbebc200000000000, 0x0000000000000000,
+    0xee6b280000000000, 0x0000000000000000,
+    0x9502f90000000000, 0x0000000000000000,
+    0xba43b74000000000, 0x0000000000000000,
+    0xe8d4a51000000000, 0x0000000000000000,
+    0x9184e72a00000000, 0x0000000000000000,
+    0xb5e620f480000000, 0x0000000000000000,
+    0xe35fa931a0000000, 0x0000000000000000,
+    0x8e1bc9bf04000000, 0x0000000000000000,
+    0xb1a2bc2ec5000000, 0x0000000000000000,
+    0xde0b6b3a76400000, 0x0000000000000000,
+    0x8ac7230489e80000, 0x0000000000000000,
+    0xad78ebc5ac620000, 0x0000000000000000,
+    0xd8d726b7177a8000, 0x0000000000000000,
+    0x878678326eac9000, 0x0000000000000000,
+    0xa968163f0a57b400, 0x0000000000000000,
+    0xd3c21bcecceda100, 0x0000000000000000,
+    0x84595161401484a0, 0x0000000000000000,
+    0xa56fa5b99019a5c8, 0x0000000000000000,
+    0xcecb8f27f4200f3a, 0x0000000000000000,
+    0x813f3978f8940984, 0x4000000000000000,
+    0xa18f07d736b90be5, 0x5000000000000000,
+    0xc9f2c9cd04674ede, 0xa400000000000000,
+    0xfc6f7c4045812296, 0x4d00000000000000,
+    0x9dc5ada82b70b59d, 0xf020000000000000,
+    0xc5371912364ce305, 0x6c28000000000000,
+    0xf684df56c3e01bc6, 0xc732000000000000,
+    0x9a130b963a6c115c, 0x3c7f400000000000,
+    0xc097ce7bc90715b3, 0x4b9f100000000000,
+    0xf0bdc21abb48db20, 0x1e86d40000000000,
+    0x96769950b50d88f4, 0x1314448000000000,
+    0xbc143fa4e250eb31, 0x17d955a000000000,
+    0xeb194f8e1ae525fd, 0x5dcfab0800000000,
+    0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+    0xb7abc627050305ad, 0xf14a3d9e40000000,
+    0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+    0x8f7e32ce7bea5c6f, 0xe4820023a2000000,
+    0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+    0xe0352f62a19e306e, 0xd50b2037ad200000,
+    0x8c213d9da502de45, 0x4526f422cc340000,
+    0xaf298d050e4395d6, 0x9670b12b7f410000,
+    0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+    0x88d8762bf324cd0f, 0xa5880a69fb6ac800,
+    0xab0e93b6efee0053, 0x8eea0d047a457a00,
+    0xd5d238a4abe98068, 0x72a4904598d6d880,
+    0x85a36366eb71f041, 0x47a6da2b7f864750,
+    0xa70c3c40a64e6c51, 0x999090b65f67d924,
+    0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+    0x82818f1281ed449f, 0xbff8f10e7a8921a4,
+    0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+    0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490,
+    0xfee50b7025c36a08, 0x02f236d04753d5b4,
+    0x9f4f2726179a2245, 0x01d762422c946590,
+    0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+    0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2,
+    0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+    0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb,
+    0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+    0x97edd871cfda3a56, 0x97758bf0e3cbb5ac,
+    0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+    0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd,
+    0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+    0xb975d6b6ee39e436, 0xb3e2fd538e122b44,
+    0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+    0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd,
+    0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+    0xe264589a4dcdab14, 0xc696963c7eed2dd1,
+    0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+    0xb0de65388cc8ada8, 0x3b25a55f43294bcb,
+    0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+    0x8a2dbf142dfcc7ab, 0x6e3569326c784337,
+    0xacb92ed9397bf996, 0x49c2c37f07965404,
+    0xd7e77a8f87daf7fb, 0xdc33745ec97be906,
+    0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+    0xa8acd7c0222311bc, 0xc40832ea0d68ce0c,
+    0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+    0x83c7088e1aab65db, 0x792667c6da79e0fa,
+    0xa4b8cab1a1563f52, 0x577001b891185938,
+    0xcde6fd5e09abcf26, 0xed4c0226b55e6f86,
+    0x80b05e5ac60b6178, 0x544f8158315b05b4,
+    0xa0dc75f1778e39d6, 0x696361ae3db1c721,
+    0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+    0xfb5878494ace3a5f, 0x04ab48a04065c723,
+    0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+    0xc45d1df942711d9a, 0x3ba5d0bd324f8394,
+    0xf5746577930d6500, 0xca8f44ec7ee36479,
+    0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb,
+    0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+    0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e,
+    0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+    0xbb445da9ca61281f, 0x2a8a6e45ae8edc97,
+    0xea1575143cf97226, 0xf52d09d71a3293bd,
+    0x924d692ca61be758, 0x593c2626705f9c56,
+    0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+    0xe498f455c38b997a, 0x0b6dfb9c0f956447,
+    0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+    0xb2977ee300c50fe7, 0x58edec91ec2cb657,
+    0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+    0x8b865b215899f46c, 0xbd79e0d20082ee74,
+    0xae67f1e9aec07187, 0xecd8590680a3aa11,
+    0xda01ee641a708de9, 0xe80e6f4820cc9495,
+    0x884134fe908658b2, 0x3109058d147fdcdd,
+    0xaa51823e34a7eede, 0xbd4b46f0599fd415,
+    0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+    0x850fadc09923329e, 0x03e2cf6bc604ddb0,
+    0xa6539930bf6bff45, 0x84db8346b786151c,
+    0xcfe87f7cef46ff16, 0xe612641865679a63,
+    0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+    0xa26da3999aef7749, 0xe3be5e330f38f09d,
+    0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+    0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6,
+    0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+    0xc646d63501a1511d, 0xb281e1fd541501b8,
+    0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+    0x9ae757596946075f, 0x3375788de9b06958,
+    0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+    0xf209787bb47d6b84, 0xc0678c5dbd23a49a,
+    0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+    0xbd176620a501fbff, 0xb650e5a93bc3d898,
+    0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+    0x93ba47c980e98cdf, 0xc66f336c36b10137,
+    0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+    0xe6d3102ad96cec1d, 0xa60dc059157491e5,
+    0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+    0xb454e4a179dd1877, 0x29babe4598c311fb,
+    0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+    0x8ce2529e2734bb1d, 0x1899e4a65f58660c,
+    0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+    0xdc21a1171d42645d, 0x76707543f4fa1f73,
+    0x899504ae72497eba, 0x6a06494a791c53a8,
+    0xabfa45da0edbde69, 0x0487db9d17636892,
+    0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+    0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2,
+    0xa7f26836f282b732, 0x8e6cac7768d7141e,
+    0xd1ef0244af2364ff, 0x3207d795430cd926,
+    0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+    0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6,
+    0xcd036837130890a1, 0x36dba887c37a8c0f,
+    0x802221226be55a64, 0xc2494954da2c9789,
+    0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+    0xc83553c5c8965d3d, 0x6f92829494e5acc7,
+    0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+    0x9c69a97284b578d7, 0xff2a760414536efb,
+    0xc38413cf25e2d70d, 0xfef5138519684aba,
+    0xf46518c2ef5b8cd1, 0x7eb258665fc25d69,
+    0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+    0xbeeefb584aff8603, 0xaafb550ffacfd8fa,
+    0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+    0x952ab45cfa97a0b2, 0xdd945a747bf26183,
+    0xba756174393d88df, 0x94f971119aeef9e4,
+    0xe912b9d1478ceb17, 0x7a37cd5601aab85d,
+    0x91abb422ccb812ee, 0xac62e055c10ab33a,
+    0xb616a12b7fe617aa, 0x577b986b314d6009,
+    0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+    0x8e41ade9fbebc27d, 0x14588f13be847307,
+    0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+    0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb,
+    0x8aec23d680043bee, 0x25de7bb9480d5854,
+    0xada72ccc20054ae9, 0xaf561aa79a10ae6a,
+    0xd910f7ff28069da4, 0x1b2ba1518094da04,
+    0x87aa9aff79042286, 0x90fb44d2f05d0842,
+    0xa99541bf57452b28, 0x353a1607ac744a53,
+    0xd3fa922f2d1675f2, 0x42889b8997915ce8,
+    0x847c9b5d7c2e09b7, 0x69956135febada11,
+    0xa59bc234db398c25, 0x43fab9837e699095,
+    0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+    0x8161afb94b44f57d, 0x1d1be0eebac278f5,
+    0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+    0xca28a291859bbf93, 0x7d7b8f7503cfdcfe,
+    0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+    0x9defbf01b061adab, 0x3a0888136afa64a7,
+    0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+    0xf6c69a72a3989f5b, 0x8aad549e57273d45,
+    0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+    0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd,
+    0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+    0x969eb7c47859e743, 0x9f644ae5a4b1b325,
+    0xbc4665b596706114, 0x873d5d9f0dde1fee,
+    0xeb57ff22fc0c7959, 0xa90cb506d155a7ea,
+    0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+    0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f,
+    0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+    0x8fa475791a569d10, 0xf96e017d694487bc,
+    0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+    0xe070f78d3927556a, 0x85bbe253f47b1417,
+    0x8c469ab843b89562, 0x93956d7478ccec8e,
+    0xaf58416654a6babb, 0x387ac8d1970027b2,
+    0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+    0x88fcf317f22241e2, 0x441fece3bdf81f03,
+    0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+    0xd60b3bd56a5586f1, 0x8a71e223d8d3b074,
+    0x85c7056562757456, 0xf6872d5667844e49,
+    0xa738c6bebb12d16c, 0xb428f8ac016561db,
+    0xd106f86e69d785c7, 0xe13336d701beba52,
+    0x82a45b450226b39c, 0xecc0024661173473,
+    0xa34d721642b06084, 0x27f002d7f95d0190,
+    0xcc20ce9bd35c78a5, 0x31ec038df7b441f4,
+    0xff290242c83396ce, 0x7e67047175a15271,
+    0x9f79a169bd203e41, 0x0f0062c6e984d386,
+    0xc75809c42c684dd1, 0x52c07b78a3e60868,
+    0xf92e0c3537826145, 0xa7709a56ccdf8a82,
+    0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+    0xc2abf989935ddbfe, 0x6acff893d00ea435,
+    0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+    0x98165af37b2153de, 0xc3727a337a8b704a,
+    0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+    0xeda2ee1c7064130c, 0x1162def06f79df73,
+    0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+    0xb9a74a0637ce2ee1, 0x6d953e2bd7173692,
+    0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+    0x910ab1d4db9914a0, 0x1d9c9892400a22a2,
+    0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+    0xe2a0b5dc971f303a, 0x2e44ae64840fd61d,
+    0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+    0xb10d8e1456105dad, 0x7425a83e872c5f47,
+    0xdd50f1996b947518, 0xd12f124e28f77719,
+    0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f,
+    0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+    0xd8210befd30efa5a, 0x3c47f7e05401aa4e,
+    0x8714a775e3e95c78, 0x65acfaec34810a71,
+    0xa8d9d1535ce3b396, 0x7f1839a741a14d0d,
+    0xd31045a8341ca07c, 0x1ede48111209a050,
+    0x83ea2b892091e44d, 0x934aed0aab460432,
+    0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+    0xce1de40642e3f4b9, 0x36251260ab9d668e,
+    0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+    0xa1075a24e4421730, 0xb24cf65b8612f81f,
+    0xc94930ae1d529cfc, 0xdee033f26797b627,
+    0xfb9b7cd9a4a7443c, 0x169840ef017da3b1,
+    0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+    0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2,
+    0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+    0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29,
+    0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+    0xeff394dcff8a948e, 0xddfc4b4cef07f5b0,
+    0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+    0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1,
+    0xea53df5fd18d5513, 0x84c86189216dc5ed,
+    0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4,
+    0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+    0xe4d5e82392a40515, 0x0fabaf3feaa5334a,
+    0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+    0xb2c71d5bca9023f8, 0x743e20e9ef511012,
+    0xdf78e4b2bd342cf6, 0x914da9246b255416,
+    0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e,
+    0xae9672aba3d0c320, 0xa184ac2473b529b1,
+    0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e,
+    0x8865899617fb1871, 0x7e2fa67c7a658892,
+    0xaa7eebfb9df9de8d, 0xddbb901b98feeab7,
+    0xd51ea6fa85785631, 0x552a74227f3ea565,
+    0x8533285c936b35de, 0xd53a88958f87275f,
+    0xa67ff273b8460356, 0x8a892abaf368f137,
+    0xd01fef10a657842c, 0x2d2b7569b0432d85,
+    0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+    0xa298f2c501f45f42, 0x8349f3ba91b47b8f,
+    0xcb3f2f7642717713, 0x241c70a936219a73,
+    0xfe0efb53d30dd4d7, 0xed238cd383aa0110,
+    0x9ec95d1463e8a506, 0xf4363804324a40aa,
+    0xc67bb4597ce2ce48, 0xb143c6053edcd0d5,
+    0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+    0x9b10a4e5e9913128, 0xca7cf2b4191c8326,
+    0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+    0xf24a01a73cf2dccf, 0xbc633b39673c8cec,
+    0x976e41088617ca01, 0xd5be0503e085d813,
+    0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18,
+    0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+    0x93e1ab8252f33b45, 0xcabb90e5c942b503,
+    0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+    0xe7109bfba19c0c9d, 0x0cc512670a783ad4,
+    0x906a617d450187e2, 0x27fb2b80668b24c5,
+    0xb484f9dc9641e9da, 0xb1f9f660802dedf6,
+    0xe1a63853bbd26451, 0x5e7873f8a0396973,
+    0x8d07e33455637eb2, 0xdb0b487b6423e1e8,
+    0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+    0xdc5c5301c56b75f7, 0x7641a140cc7810fb,
+    0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+    0xac2820d9623bf429, 0x546345fa9fbdcd44,
+    0xd732290fbacaf133, 0xa97c177947ad4095,
+    0x867f59a9d4bed6c0, 0x49ed8eabcccc485d,
+    0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+    0xd226fc195c6a2f8c, 0x73832eec6fff3111,
+    0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+    0xa42e74f3d032f525, 0xba3e7ca8b77f5e55,
+    0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+    0x80444b5e7aa7cf85, 0x7980d163cf5b81b3,
+    0xa0555e361951c366, 0xd7e105bcc332621f,
+    0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7,
+    0xfa856334878fc150, 0xb14f98f6f0feb951,
+    0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3,
+    0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+    0xf4a642e14c6262c8, 0xcd27bb612758c0fa,
+    0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+    0xbf21e44003acdd2c, 0xe0470a63e6bd56c3,
+    0xeeea5d5004981478, 0x1858ccfce06cac74,
+    0x95527a5202df0ccb, 0x0f37801e0c43ebc8,
+    0xbaa718e68396cffd, 0xd30560258f54e6ba,
+    0xe950df20247c83fd, 0x47c6b82ef32a2069,
+    0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+    0xb6472e511c81471d, 0xe0133fe4adf8e952,
+    0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+    0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648,
+};
+
+// Return the high 64 bits of the 128-bit product of `a` and `b`, setting `lo` to the low 64 bits.
+static inline npy_uint64
+AK_mul_128(npy_uint64 a, npy_uint64 b, npy_uint64 *lo)
+{
+# if defined __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t)a * b;
+    *lo = (npy_uint64)r;
+    return (npy_uint64)(r >> 64);
+# else
+    npy_uint64 a_lo = (npy_uint32)a, a_hi = a >> 32;
+    npy_uint64 b_lo = (npy_uint32)b, b_hi = b >> 32;
+    npy_uint64 ll = a_lo * b_lo;
+    npy_uint64 lh = a_lo * b_hi;
+    npy_uint64 hl = a_hi * b_lo;
+    npy_uint64 hh = a_hi * b_hi;
+    npy_uint64 mid = (ll >> 32) + (npy_uint32)lh + (npy_uint32)hl;
+    *lo = (mid << 32) | (npy_uint32)ll;
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+# endif
+}
+
+static inline int
+AK_clz64(npy_uint64 x)
+{
+# if defined __GNUC__ || defined __clang__
+    return __builtin_clzll(x);
+# else
+    int n = 0;
+    while (!(x & ((npy_uint64)1 << 63))) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+# endif
+}
+
+// Given a non-zero decimal significand `w` and exponent `q`, set `bits` to the IEEE binary64 representation of w * 10^q, correctly rounded, using the algorithm of Eisel and Lemire (as in the fast_float library). Returns false, without setting `bits`, if the result cannot be determined without more precision.
+static inline bool
+AK_float64_eisel_lemire(npy_uint64 w, Py_ssize_t q, npy_uint64 *bits)
+{
+    if (q < AK_POW5_MIN) {
+        *bits = 0;
+        return true;
+    }
+    if (q > AK_POW5_MAX) {
+        *bits = (npy_uint64)0x7FF << 52; // infinity
+        return true;
+    }
+    int lz = AK_clz64(w);
+    w <<= lz;
+
+    // with 55 bits of precision (52 explicit mantissa bits, plus 3), only use the second word if the first is inconclusive
+    const npy_uint64 *pow5 = AK_pow5_128 + 2 * (q - AK_POW5_MIN);
+    npy_uint64 lo;
+    npy_uint64 hi = AK_mul_128(w, pow5[0], &lo);
+    if ((hi & 0x1FF) == 0x1FF) {
+        npy_uint64 lo2;
+        npy_uint64 hi2 = AK_mul_128(w, pow5[1], &lo2);
+        lo += hi2;
+        if (hi2 > lo) ++hi;
+    }
+    // in very rare cases, more precision is needed; within these exponents, the product is exact
+    if (lo == NPY_MAX_UINT64 && (q < -27 || q > 55)) return false;
+    int upperbit = (int)(hi >> 63);
+    int shift = upperbit + 64 - 52 - 3;
+    npy_uint64 mantissa = hi >> shift;
+    // this approximates floor(log2(10^q)) + 63, then removes the exponent bias of -1023
+    npy_int64 power2 = (((152170 + 65536) * (npy_int64)q) >> 16) + 63 + upperbit - lz + 1023;
+
+    if (power2 <= 0) { // subnormal
+        if (-power2 + 1 >= 64) {
+            *bits = 0;
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = (mantissa < ((npy_uint64)1 << 52)) ? 0 : 1;
+        *bits = mantissa | ((npy_uint64)power2 << 52);
+        return true;
+    }
+    // if exactly halfway, round to even
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1) {
+        if ((mantissa << shift) == hi) mantissa &= ~(npy_uint64)1;
+    }
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= ((npy_uint64)2 << 52)) {
+        mantissa = (npy_uint64)1 << 52;
+        ++power2;
+    }
+    mantissa &= ~((npy_uint64)1 << 52);
+    if (power2 >= 0x7FF) {
+        power2 = 0x7FF;
+        mantissa = 0;
+    }
+    *bits = mantissa | ((npy_uint64)power2 << 52);
+    return true;
+}
+
+// The maximum number of significant digits given to strtod by AK_float64_fallback.
+# define AK_FLOAT64_FALLBACK_DIGITS 768
+
+// Convert the significant digits between `p` and `end`, skipping `tsep` and `decc`, with a decimal exponent `q` applied to the last digit copied, using strtod; `fraction` is true if `p` is after the decimal character. Used when the result cannot be determined by AK_float64_eisel_lemire. As the string given to strtod has no decimal point, this is not dependent on locale. Digits beyond AK_FLOAT64_FALLBACK_DIGITS are ignored.
+static npy_float64
+AK_float64_fallback(Py_UCS1 *p,
+        Py_UCS1 *end,
+        bool fraction,
+        Py_ssize_t q,
+        char tsep,
+        char decc)
+{
+    char buffer[AK_FLOAT64_FALLBACK_DIGITS + 32];
+    char *b = buffer;
+    Py_ssize_t count = 0;
+
+    for (; p < end; ++p) {
+        if (!fraction && *p == (Py_UCS1)decc) {
+            fraction = true;
+            continue;
+        }
+        if (!fraction && tsep != '\0' && *p == (Py_UCS1)tsep) continue;
+        if (!AK_is_digit(*p)) break;
+        if (count == 0 && *p == '0') {
+            if (fraction) --q;
+            continue;
+        }
+        if (count < AK_FLOAT64_FALLBACK_DIGITS) {
+            *b++ = (char)*p;
+            ++count;
+            if (fraction) --q;
+        }
+        else if (!fraction) {
+            ++q;
+        }
+    }
+    snprintf(b, 32, "e%zd", q);
+    return strtod(buffer, NULL);
+}
+
+# if NPY_BYTE_ORDER == NPY_LITTLE_ENDIAN
+// Return true if the 8 bytes read from `p` are all ASCII digits.
+static inline bool
+AK_is_eight_digits(npy_uint64 v)
+{
+    return !(((v + 0x4646464646464646) | (v - 0x3030303030303030)) & 0x8080808080808080);
+}
+
+// Return the integer value of 8 ASCII digits read from memory as a little-endian integer.
+static inline npy_uint32
+AK_parse_eight_digits(npy_uint64 v)
+{
+    const npy_uint64 mask = 0x000000FF000000FF;
+    const npy_uint64 mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    const npy_uint64 mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return (npy_uint32)v;
+}
+# endif
+
+// Given a pointer to the first significant digit of a number with more than 19 significant digits, set `w` to the first 19 significant digits and `q` to the decimal exponent of the last of these digits (excluding the exponent given after an "e"); return true if any further digits are non-zero. `fraction` is true if `p` is after the decimal character.
+static bool
+AK_float64_truncate(Py_UCS1 *p,
+        Py_UCS1 *end,
+        bool fraction,
+        char tsep,
+        char decc,
+        npy_uint64 *w,
+        Py_ssize_t *q)
+{
+    npy_uint64 v = 0;
+    Py_ssize_t count = 0;
+    Py_ssize_t exp = 0;
+    bool truncated = false;
+
+    for (; p < end; ++p) {
+        if (!fraction && *p == (Py_UCS1)decc) {
+            fraction = true;
+            continue;
+        }
+        if (!fraction && tsep != '\0' && *p == (Py_UCS1)tsep) continue;
+        if (!AK_is_digit(*p)) break;
+        if (count < 19) {
+            v = v * 10 + (*p - '0');
+            ++count;
+            if (fraction) --exp;
+        }
+        else {
+            if (!fraction) ++exp;
+            truncated |= *p != '0';
+        }
+    }
+    *w = v;
+    *q = exp;
+    return truncated;
+}
+
+// Convert a field to a float64, correctly rounded. Significant digits are accumulated in an integer; the value is then found with an exact multiplication or division by a power of ten when possible (Clinger's fast path), otherwise with AK_float64_eisel_lemire, falling back to strtod only in rare cases. Leading and trailing space is permitted. Sets error on failure; does not set an exception.
 static inline npy_float64
-AK_UCS4_to_float64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep, char decc)
+AK_UCS1_to_float64(Py_UCS1 *p_item, Py_UCS1 *end, int *error, char tsep, char decc)
 {
-    // Cache powers of 10 in memory.
-    static npy_float64 e[] = {
+    // Exactly representable powers of 10.
+    static const npy_float64 e[] = {
         1.,    1e1,   1e2,   1e3,   1e4,   1e5,   1e6,   1e7,   1e8,   1e9,
         1e10,  1e11,  1e12,  1e13,  1e14,  1e15,  1e16,  1e17,  1e18,  1e19,
-        1e20,  1e21,  1e22,  1e23,  1e24,  1e25,  1e26,  1e27,  1e28,  1e29,
-        1e30,  1e31,  1e32,  1e33,  1e34,  1e35,  1e36,  1e37,  1e38,  1e39,
-        1e40,  1e41,  1e42,  1e43,  1e44,  1e45,  1e46,  1e47,  1e48,  1e49,
-        1e50,  1e51,  1e52,  1e53,  1e54,  1e55,  1e56,  1e57,  1e58,  1e59,
-        1e60,  1e61,  1e62,  1e63,  1e64,  1e65,  1e66,  1e67,  1e68,  1e69,
-        1e70,  1e71,  1e72,  1e73,  1e74,  1e75,  1e76,  1e77,  1e78,  1e79,
-        1e80,  1e81,  1e82,  1e83,  1e84,  1e85,  1e86,  1e87,  1e88,  1e89,
-        1e90,  1e91,  1e92,  1e93,  1e94,  1e95,  1e96,  1e97,  1e98,  1e99,
-        1e100, 1e101, 1e102, 1e103, 1e104, 1e105, 1e106, 1e107, 1e108, 1e109,
-        1e110, 1e111, 1e112, 1e113, 1e114, 1e115, 1e116, 1e117, 1e118, 1e119,
-        1e120, 1e121, 1e122, 1e123, 1e124, 1e125, 1e126, 1e127, 1e128, 1e129,
-        1e130, 1e131, 1e132, 1e133, 1e134, 1e135, 1e136, 1e137, 1e138, 1e139,
-        1e140, 1e141, 1e142, 1e143, 1e144, 1e145, 1e146, 1e147, 1e148, 1e149,
-        1e150, 1e151, 1e152, 1e153, 1e154, 1e155, 1e156, 1e157, 1e158, 1e159,
-        1e160, 1e161, 1e162, 1e163, 1e164, 1e165, 1e166, 1e167, 1e168, 1e169,
-        1e170, 1e171, 1e172, 1e173, 1e174, 1e175, 1e176, 1e177, 1e178, 1e179,
-        1e180, 1e181, 1e182, 1e183, 1e184, 1e185, 1e186, 1e187, 1e188, 1e189,
-        1e190, 1e191, 1e192, 1e193, 1e194, 1e195, 1e196, 1e197, 1e198, 1e199,
-        1e200, 1e201, 1e202, 1e203, 1e204, 1e205, 1e206, 1e207, 1e208, 1e209,
-        1e210, 1e211, 1e212, 1e213, 1e214, 1e215, 1e216, 1e217, 1e218, 1e219,
-        1e220, 1e221, 1e222, 1e223, 1e224, 1e225, 1e226, 1e227, 1e228, 1e229,
-        1e230, 1e231, 1e232, 1e233, 1e234, 1e235, 1e236, 1e237, 1e238, 1e239,
-        1e240, 1e241, 1e242, 1e243, 1e244, 1e245, 1e246, 1e247, 1e248, 1e249,
-        1e250, 1e251, 1e252, 1e253, 1e254, 1e255, 1e256, 1e257, 1e258, 1e259,
-        1e260, 1e261, 1e262, 1e263, 1e264, 1e265, 1e266, 1e267, 1e268, 1e269,
-        1e270, 1e271, 1e272, 1e273, 1e274, 1e275, 1e276, 1e277, 1e278, 1e279,
-        1e280, 1e281, 1e282, 1e283, 1e284, 1e285, 1e286, 1e287, 1e288, 1e289,
-        1e290, 1e291, 1e292, 1e293, 1e294, 1e295, 1e296, 1e297, 1e298, 1e299,
-        1e300, 1e301, 1e302, 1e303, 1e304, 1e305, 1e306, 1e307, 1e308};
-
-    npy_float64 number = 0.0;
-    int exponent = 0;
+        1e20,  1e21,  1e22};
+
+    npy_uint64 w = 0; // significand; wraps if there are more than 19 digits
+    Py_ssize_t q = 0; // decimal exponent
+    Py_ssize_t digits = 0; // significant digits
+    Py_ssize_t zeros = 0; // leading zeros after decc
+    bool truncated = false; // a non-zero fraction digit did not fit in w
+    bool any_digits = false;
     bool negative_base = false;
     bool negative_e = false;
+    Py_ssize_t n = 0;
+    npy_float64 number = 0.0;
 
-    int num_digits = 0;
-    int max_digits = 17;
-    int n = 0;
-
-    Py_UCS4 *p = p_item;
+    Py_UCS1 *p = p_item;
     while (AK_is_space(*p)) {
         ++p;
         if (p >= end) return number;
@@ -1097,7 +2313,8 @@ AK_UCS4_to_float64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep, char de
             if (AK_is_f(*p)) {
                 p++;
                 while (p < end) {
-                    if (!AK_is_space(*p++)) goto error;
+                    if (!AK_is_space(*p)) goto error;
+                    ++p;
                 }
                 if (negative_base) return -NPY_INFINITY;
                 return NPY_INFINITY;
@@ -1114,50 +2331,70 @@ AK_UCS4_to_float64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep, char de
             if (AK_is_n(*p)) {
                 p++;
                 while (p < end) {
-                    if (!AK_is_space(*p++)) goto error;
+                    if (!AK_is_space(*p)) goto error;
+                    ++p;
                 }
                 return NPY_NAN;
             }
         }
         goto error; // matched n but nothing else
     }
-    while (AK_is_digit(*p)) {
-        if (num_digits < max_digits) {
-            number = number * 10. + (*p - '0');
-            num_digits++;
-        } else {
-            ++exponent;
-        }
-        p++;
-        if (p >= end) goto exit;
-        if (tsep != '\0' && *p == (Py_UCS4)tsep) {
-            ++p;
-            if (p >= end) goto exit;
-        }
+    // leading zeros are not significant
+    while (p < end && *p == '0') {
+        any_digits = true;
+        ++p;
+        if (tsep != '\0' && p < end && *p == (Py_UCS1)tsep) ++p;
     }
-
-    if (*p == (Py_UCS4)decc) {
+    Py_UCS1 *p_significant = p;
+    bool significant_fraction = false; // if p_significant is after decc
+    while (p < end && AK_is_digit(*p)) {
+        w = w * 10 + (npy_uint64)(*p - '0');
+        ++digits;
+        ++p;
+        if (tsep != '\0' && p < end && *p == (Py_UCS1)tsep) ++p;
+    }
+    if (p < end && *p == (Py_UCS1)decc) {
         p++;
-        if (p >= end) goto exit;
-
-        while (num_digits < max_digits && AK_is_digit(*p)) {
-            number = number * 10. + (*p - '0');
-            num_digits++;
-            exponent--;
-            p++;
-            if (p >= end) goto exit;
-        }
-        if (num_digits >= max_digits)  // Consume extra decimal digits.
-            while (AK_is_digit(*p)) {
+        if (digits == 0) {
+            while (p < end && *p == '0') {
+                any_digits = true;
+                ++zeros;
                 ++p;
-                if (p >= end) goto exit;
             }
+            p_significant = p;
+            significant_fraction = true;
+        }
+        // only read fraction digits into w up to 19 significant digits
+        Py_UCS1 *p_fraction = p;
+        Py_UCS1 *p_limit = p + (digits < 19 ? 19 - digits : 0);
+        if (p_limit > end) p_limit = end;
+# if NPY_BYTE_ORDER == NPY_LITTLE_ENDIAN
+        npy_uint64 v;
+        while (p_limit - p >= 8) {
+            memcpy(&v, p, 8);
+            if (!AK_is_eight_digits(v)) break;
+            w = w * 100000000 + AK_parse_eight_digits(v);
+            p += 8;
+        }
+# endif
+        while (p < p_limit && AK_is_digit(*p)) {
+            w = w * 10 + (npy_uint64)(*p - '0');
+            ++p;
+        }
+        digits += p - p_fraction;
+        q -= zeros + (p - p_fraction);
+        // further digits do not fit in w
+        while (p < end && AK_is_digit(*p)) {
+            truncated |= *p != '0';
+            ++p;
+        }
     }
-    if (num_digits == 0) {
+    any_digits |= digits > 0;
+    if (!any_digits) {
         *error = ERANGE;
         return 0.0;
     }
-    if (AK_is_e(*p)) {
+    if (p < end && AK_is_e(*p)) {
         ++p;
         if (p >= end) goto exit;
 
@@ -1169,45 +2406,87 @@ AK_UCS4_to_float64(Py_UCS4 *p_item, Py_UCS4 *end, int *error, char tsep, char de
                 p++;
                 if (p >= end) goto exit; // sign is not used
         }
-        num_digits = 0; // reset
-        while (num_digits < max_digits && AK_is_digit(*p)) {
-            n = n * 10 + (*p - '0');
-            num_digits++;
+        while (p < end && AK_is_digit(*p)) {
+            if (n < 100000) n = n * 10 + (*p - '0'); // beyond this, always zero or infinity
             p++;
-            if (p >= end) goto exit;
         }
     }
     // if we have anything but space trailing, error
     while (p < end) {
-        if (!AK_is_space(*p++)) goto error;
+        if (!AK_is_space(*p)) goto error;
+        ++p;
     }
 exit:
-    if (negative_base) number = -number;
-    // n will be zero if no E found
-    if (negative_e) {
-        exponent -= n;
+    if (negative_e) n = -n;
+
+    if (digits == 0) {
+        number = 0.0;
+    }
+    else if (digits <= 19) {
+        q += n;
+        npy_uint64 bits;
+        npy_uint64 bits_next;
+        if (truncated) {
+            // the value is between w and w + 1; the result is only known if both round to the same value
+            if (AK_float64_eisel_lemire(w, q, &bits)
+                    && AK_float64_eisel_lemire(w + 1, q, &bits_next)
+                    && bits == bits_next) {
+                memcpy(&number, &bits, sizeof(number));
+            }
+            else {
+                number = AK_float64_fallback(p_significant,
+                        end,
+                        significant_fraction,
+                        n - zeros,
+                        tsep,
+                        decc);
+            }
+        }
+        else if (w <= ((npy_uint64)1 << 53) && q >= -22 && q <= 22) {
+            // both w and the power of 10 are exact, so one operation is correctly rounded
+            number = q < 0 ? (npy_float64)w / e[-q] : (npy_float64)w * e[q];
+        }
+        else {
+            if (AK_float64_eisel_lemire(w, q, &bits)) {
+                memcpy(&number, &bits, sizeof(number));
+            }
+            else {
+                number = AK_float64_fallback(p_significant,
+                        end,
+                        significant_fraction,
+                        n - zeros,
+                        tsep,
+                        decc);
+            }
+        }
     }
     else {
-        exponent += n;
-    }
-    // AK_DEBUG_MSG_OBJ("at exit", PyLong_FromLong(exponent));
-    // done with p at this point
-    if (exponent > 308) {
-        *error = ERANGE;
-        return HUGE_VAL;
-    } else if (exponent > 0) {
-        number *= e[exponent];
-    } else if (exponent < -308) {  // Subnormal
-        if (exponent < -616) {  // Prevent invalid array access.
-            number = 0.;
-        } else {
-            number /= e[-308 - exponent];
-            number /= e[308];
+        // more than 19 integer digits
+        truncated = AK_float64_truncate(p_significant,
+                end,
+                significant_fraction,
+                tsep,
+                decc,
+                &w,
+                &q);
+        q += n - zeros;
+        npy_uint64 bits;
+        npy_uint64 bits_next;
+        if (AK_float64_eisel_lemire(w, q, &bits)
+                && (!truncated
+                || (AK_float64_eisel_lemire(w + 1, q, &bits_next) && bits == bits_next))) {
+            memcpy(&number, &bits, sizeof(number));
+        }
+        else {
+            number = AK_float64_fallback(p_significant,
+                    end,
+                    significant_fraction,
+                    n - zeros,
+                    tsep,
+                    decc);
         }
-    } else {
-        number /= e[-exponent];
     }
-
+    if (negative_base) number = -number;
     if (number == HUGE_VAL || number == -HUGE_VAL) *error = ERANGE;
     return number;
 error:
@@ -1216,64 +2495,590 @@ error:
 }
 
 //------------------------------------------------------------------------------
-// CodePointLine
+// Complex parsing
 
-// An AK_CodePointLine stores a contiguous buffer of Py_UCS4 without null terminators between fields. Separately, we store an array of integers, where each integer is the size of each field. The total number of fields is given by offset_count.
-typedef struct AK_CodePointLine{
-    // NOTE: should these be unsigned int types, like Py_uintptr_t?
-    Py_ssize_t buffer_count; // accumulated number of code points
-    Py_ssize_t buffer_capacity; // max number of code points
-    Py_UCS4 *buffer;
+// Return the end of a float token starting at `p`: an optional sign followed by digits with an optional decimal and exponent, or by inf or nan. Returns NULL if there is no such token.
+static inline Py_UCS1*
+AK_UCS1_float_token(Py_UCS1 *p, Py_UCS1 *end, char decc)
+{
+    if (p < end && AK_is_sign(*p)) ++p;
+    if (end - p >= 3) {
+        if (AK_is_i(p[0]) && AK_is_n(p[1]) && AK_is_f(p[2])) return p + 3;
+        if (AK_is_n(p[0]) && AK_is_a(p[1]) && AK_is_n(p[2])) return p + 3;
+    }
+    Py_ssize_t digits = 0;
+    while (p < end && AK_is_digit(*p)) {
+        ++p;
+        ++digits;
+    }
+    if (p < end && *p == (Py_UCS1)decc) {
+        ++p;
+        while (p < end && AK_is_digit(*p)) {
+            ++p;
+            ++digits;
+        }
+    }
+    if (digits == 0) return NULL;
+    if (p < end && AK_is_e(*p)) {
+        ++p;
+        if (p < end && AK_is_sign(*p)) ++p;
+        if (p == end || !AK_is_digit(*p)) return NULL;
+        while (p < end && AK_is_digit(*p)) ++p;
+    }
+    return p;
+}
 
-    Py_ssize_t offsets_count; // accumulated number of elements, never reset
+// Parse a float token as delimited by AK_UCS1_float_token. Returns 0 on success, -1 if out of range.
+static inline int
+AK_UCS1_float_token_value(Py_UCS1 *p, Py_UCS1 *end, char decc, npy_float64 *value)
+{
+    int error = 0;
+    *value = AK_UCS1_to_float64(p, end, &error, '\0', decc);
+    return error ? -1 : 0;
+}
+
+// Parse a complex of the forms accepted by Python's complex(): a real part, an imaginary part ending in j or J, or a real part followed by a signed imaginary part, optionally in parentheses, with surrounding spaces ignored. Returns 0 on success, -1 if the string could not be interpreted.
+static inline int
+AK_UCS1_to_complex(Py_UCS1 *p,
+        Py_UCS1 *end,
+        char decc,
+        npy_float64 *real,
+        npy_float64 *imag)
+{
+    while (p < end && AK_is_space(*p)) ++p;
+    while (end > p && AK_is_space(*(end - 1))) --end;
+    if (p < end && AK_is_paren_open(*p)) {
+        if (!AK_is_paren_close(*(end - 1))) return -1;
+        ++p;
+        --end;
+        while (p < end && AK_is_space(*p)) ++p;
+        while (end > p && AK_is_space(*(end - 1))) --end;
+    }
+    *real = 0;
+    *imag = 0;
+    Py_UCS1 *p_real_end = AK_UCS1_float_token(p, end, decc);
+    if (p_real_end == NULL) {
+        // an imaginary unit with an optional sign
+        Py_UCS1 *j = p < end && AK_is_sign(*p) ? p + 1 : p;
+        if (j + 1 != end || !AK_is_j(*j)) return -1;
+        *imag = *p == '-' ? -1 : 1;
+        return 0;
+    }
+    if (p_real_end == end) {
+        return AK_UCS1_float_token_value(p, p_real_end, decc, real);
+    }
+    if (AK_is_j(*p_real_end) && p_real_end + 1 == end) {
+        return AK_UCS1_float_token_value(p, p_real_end, decc, imag);
+    }
+    if (!AK_is_sign(*p_real_end)
+            || AK_UCS1_float_token_value(p, p_real_end, decc, real)) {
+        return -1;
+    }
+    p = p_real_end;
+    Py_UCS1 *p_imag_end = AK_UCS1_float_token(p, end, decc);
+    if (p_imag_end == NULL) {
+        if (p + 2 != end || !AK_is_j(p[1])) return -1;
+        *imag = *p == '-' ? -1 : 1;
+        return 0;
+    }
+    if (p_imag_end + 1 != end || !AK_is_j(*p_imag_end)) return -1;
+    return AK_UCS1_float_token_value(p, p_imag_end, decc, imag);
+}
+
+//------------------------------------------------------------------------------
+// ISO 8601 datetime parsing
+
+// A datetime parsed from an ISO 8601 string. The unit is the resolution given by the string, or NPY_FR_GENERIC for NaT. Any timezone offset has already been applied, such that days and nanoseconds are UTC.
+typedef struct AK_Datetime {
+    NPY_DATETIMEUNIT unit;
+    npy_int64 year;
+    int month;
+    npy_int64 days; // days since the epoch
+    npy_int64 nanoseconds; // nanoseconds since the start of the day
+} AK_Datetime;
+
+#define AK_NS_PER_DAY 86400000000000LL
+
+// Days since 1970-01-01 for a proleptic Gregorian date; from Howard Hinnant's days_from_civil.
+static inline npy_int64
+AK_days_from_civil(npy_int64 year, int month, int day)
+{
+    year -= month <= 2;
+    npy_int64 era = (year >= 0 ? year : year - 399) / 400;
+    npy_int64 yoe = year - era * 400;
+    npy_int64 doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    npy_int64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// The inverse of AK_days_from_civil, only providing year and month.
+static inline void
+AK_civil_from_days(npy_int64 days, npy_int64 *year, int *month)
+{
+    days += 719468;
+    npy_int64 era = (days >= 0 ? days : days - 146096) / 146097;
+    npy_int64 doe = days - era * 146097;
+    npy_int64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    npy_int64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    npy_int64 mp = (5 * doy + 2) / 153;
+    *month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *year = yoe + era * 400 + (*month <= 2);
+}
+
+// Read exactly `count` digits into `value`. Returns false if any are not digits.
+static inline bool
+AK_UCS1_digits(Py_UCS1 *p, int count, int *value)
+{
+    int v = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!AK_is_digit(p[i])) return false;
+        v = v * 10 + (p[i] - '0');
+    }
+    *value = v;
+    return true;
+}
+
+// Parse an ISO 8601 date or datetime, of the form YYYY[-MM[-DD[(T| )hh[:mm[:ss[.f]]][Z|(+|-)hh[[:]mm]]]]], with up to nine fractional second digits; leading spaces are ignored, and an empty string or "NaT" (in any case) is NaT. This covers a subset of what NumPy parses; strings outside of it (as well as invalid dates) are not interpreted. Returns 0 on success, -1 if the string could not be interpreted.
+static inline int
+AK_UCS1_to_datetime(Py_UCS1 *p, Py_UCS1 *end, AK_Datetime *dt)
+{
+    if (p == end || (end - p == 3
+            && AK_is_n(p[0]) && AK_is_a(p[1]) && AK_is_t(p[2]))) {
+        dt->unit = NPY_FR_GENERIC;
+        return 0;
+    }
+    while (p < end && AK_is_space(*p)) ++p;
+    int year, month = 1, day = 1, hour = 0, minute = 0, second = 0;
+    npy_int64 fraction = 0;
+    NPY_DATETIMEUNIT unit;
+
+    if (end - p < 4 || !AK_UCS1_digits(p, 4, &year)) return -1;
+    p += 4;
+    unit = NPY_FR_Y;
+    if (p < end) {
+        if (end - p < 3 || *p != '-' || !AK_UCS1_digits(p + 1, 2, &month)) return -1;
+        p += 3;
+        unit = NPY_FR_M;
+    }
+    if (p < end) {
+        if (end - p < 3 || *p != '-' || !AK_UCS1_digits(p + 1, 2, &day)) return -1;
+        p += 3;
+        unit = NPY_FR_D;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > AK_days_in_month(year, month)) {
+        return -1;
+    }
+    int offset = 0; // minutes east of UTC
+    if (p < end) {
+        if (end - p < 3 || (*p != 'T' && *p != ' ') || !AK_UCS1_digits(p + 1, 2, &hour)) {
+            return -1;
+        }
+        p += 3;
+        unit = NPY_FR_h;
+        if (p < end && *p == ':') {
+            if (end - p < 3 || !AK_UCS1_digits(p + 1, 2, &minute)) return -1;
+            p += 3;
+            unit = NPY_FR_m;
+            if (p < end && *p == ':') {
+                if (end - p < 3 || !AK_UCS1_digits(p + 1, 2, &second)) return -1;
+                p += 3;
+                unit = NPY_FR_s;
+                if (p < end && *p == '.') {
+                    ++p;
+                    int digits = 0;
+                    while (p < end && AK_is_digit(*p)) {
+                        if (++digits > 9) return -1;
+                        fraction = fraction * 10 + (*p++ - '0');
+                    }
+                    if (digits == 0) return -1;
+                    unit = digits <= 3 ? NPY_FR_ms : digits <= 6 ? NPY_FR_us : NPY_FR_ns;
+                    for (; digits < 9; ++digits) fraction *= 10;
+                }
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 59) return -1;
+        // timezone
+        if (p < end && *p == 'Z') {
+            ++p;
+        }
+        else if (p < end && AK_is_sign(*p)) {
+            int sign = *p++ == '-' ? -1 : 1;
+            int tz_hour, tz_minute = 0;
+            if (end - p < 2 || !AK_UCS1_digits(p, 2, &tz_hour)) return -1;
+            p += 2;
+            if (p < end && *p == ':') ++p;
+            if (p < end) {
+                if (end - p < 2 || !AK_UCS1_digits(p, 2, &tz_minute)) return -1;
+                p += 2;
+            }
+            if (tz_hour > 23 || tz_minute > 59) return -1;
+            offset = sign * (tz_hour * 60 + tz_minute);
+        }
+        if (p != end) return -1;
+    }
+    dt->unit = unit;
+    dt->year = year;
+    dt->month = month;
+    dt->days = AK_days_from_civil(year, month, day);
+    dt->nanoseconds = ((hour * 60 + minute - offset) * 60 + second) * 1000000000LL + fraction;
+    if (offset) {
+        if (dt->nanoseconds < 0) {
+            dt->nanoseconds += AK_NS_PER_DAY;
+            --dt->days;
+        }
+        else if (dt->nanoseconds >= AK_NS_PER_DAY) {
+            dt->nanoseconds -= AK_NS_PER_DAY;
+            ++dt->days;
+        }
+        AK_civil_from_days(dt->days, &dt->year, &dt->month);
+    }
+    return 0;
+}
+
+// Convert a parsed datetime to ticks of `unit`, truncating any finer resolution. Returns 0 on success, -1 if the unit is not supported or the value cannot be represented.
+static inline int
+AK_datetime_to_ticks(AK_Datetime *dt, NPY_DATETIMEUNIT unit, npy_int64 *ticks)
+{
+    if (dt->unit == NPY_FR_GENERIC) {
+        *ticks = NPY_DATETIME_NAT;
+        return 0;
+    }
+    npy_int64 days = dt->days;
+    npy_int64 ns = dt->nanoseconds;
+    switch (unit) {
+        case NPY_FR_Y:
+            *ticks = dt->year - 1970;
+            return 0;
+        case NPY_FR_M:
+            *ticks = (dt->year - 1970) * 12 + dt->month - 1;
+            return 0;
+        case NPY_FR_W:
+            *ticks = (days >= 0 ? days : days - 6) / 7;
+            return 0;
+        case NPY_FR_D:
+            *ticks = days;
+            return 0;
+        case NPY_FR_h:
+            *ticks = days * 24 + ns / 3600000000000LL;
+            return 0;
+        case NPY_FR_m:
+            *ticks = days * 1440 + ns / 60000000000LL;
+            return 0;
+        case NPY_FR_s:
+            *ticks = days * 86400 + ns / 1000000000LL;
+            return 0;
+        case NPY_FR_ms:
+            *ticks = days * 86400000LL + ns / 1000000LL;
+            return 0;
+        case NPY_FR_us:
+            *ticks = days * 86400000000LL + ns / 1000LL;
+            return 0;
+        case NPY_FR_ns:
+            // nanoseconds from the epoch are limited to about 292 years
+            if (days < -106751 || days > 106750) return -1;
+            *ticks = days * AK_NS_PER_DAY + ns;
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+//------------------------------------------------------------------------------
+// AK_NAValues: tokens that denote missing values. Fields matching a token are stored as empty fields, such that they type parse as empty and are converted to NaN or NaT; an inferred bool line with an NA value is a str line. In a line of a given str or bytes dtype, an NA value is an empty string; in a line of a given integer or bool dtype, which cannot represent a missing value, an NA value raises.
+
+typedef struct AK_NAToken {
+    Py_ssize_t len;
+    Py_UCS4 *points;
+} AK_NAToken;
+
+typedef struct AK_NAValues {
+    AK_NAToken *tokens;
+    Py_ssize_t count;
+    npy_uint64 len_mask; // bit n is set if a token has n code points; bit 63 for 63 or more
+} AK_NAValues;
+
+// Return the bit in len_mask for a length of `len` code points.
+static inline npy_uint64
+AK_NA_len_bit(Py_ssize_t len)
+{
+    return (npy_uint64)1 << (len < 63 ? len : 63);
+}
+
+// Return true if the field of `len` code points of `kind` equals a token. Fields of a length no token has are rejected without comparison. Does not require the GIL.
+static inline bool
+AK_NA_match(const AK_NAValues *na, int kind, const void *field, Py_ssize_t len)
+{
+    if (!(na->len_mask & AK_NA_len_bit(len))) return false;
+    for (Py_ssize_t i = 0; i < na->count; ++i) {
+        const AK_NAToken *t = na->tokens + i;
+        if (t->len != len) continue;
+        Py_ssize_t j = 0;
+        while (j < len && PyUnicode_READ(kind, field, j) == t->points[j]) ++j;
+        if (j == len) return true;
+    }
+    return false;
+}
+
+static void
+AK_NA_Free(AK_NAValues *na)
+{
+    if (na == NULL) return;
+    for (Py_ssize_t i = 0; i < na->count; ++i) {
+        PyMem_Free(na->tokens[i].points);
+    }
+    PyMem_Free(na->tokens);
+    PyMem_Free(na);
+}
+
+// Return a new AK_NAValues from an iterable of str; returns NULL with no exception set if `na_values` is NULL or None, or NULL with an exception set on error.
+static AK_NAValues*
+AK_NA_New(PyObject *na_values)
+{
+    if (na_values == NULL || na_values == Py_None) return NULL;
+    if (PyUnicode_Check(na_values)) {
+        PyErr_SetString(PyExc_TypeError, "na_values must be an iterable of str, or None");
+        return NULL;
+    }
+    PyObject *seq = PySequence_Fast(na_values, "na_values must be an iterable of str, or None");
+    if (seq == NULL) return NULL;
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(seq);
+
+    AK_NAValues *na = (AK_NAValues*)PyMem_Malloc(sizeof(AK_NAValues));
+    if (na == NULL) {
+        Py_DECREF(seq);
+        return (AK_NAValues*)PyErr_NoMemory();
+    }
+    na->count = 0;
+    na->len_mask = 0;
+    na->tokens = (AK_NAToken*)PyMem_Malloc(sizeof(AK_NAToken) * (size > 0 ? size : 1));
+    if (na->tokens == NULL) {
+        PyMem_Free(na);
+        Py_DECREF(seq);
+        return (AK_NAValues*)PyErr_NoMemory();
+    }
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject *token = PySequence_Fast_GET_ITEM(seq, i);
+        if (!PyUnicode_Check(token)) {
+            PyErr_Format(PyExc_TypeError,
+                    "na_values must be str, not %.200s",
+                    Py_TYPE(token)->tp_name);
+            goto error;
+        }
+        AK_NAToken *t = na->tokens + na->count;
+        t->points = PyUnicode_AsUCS4Copy(token);
+        if (t->points == NULL) goto error;
+        t->len = PyUnicode_GET_LENGTH(token);
+        na->len_mask |= AK_NA_len_bit(t->len);
+        ++na->count;
+    }
+    Py_DECREF(seq);
+    return na;
+error:
+    Py_DECREF(seq);
+    AK_NA_Free(na);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Field conversion
+
+// This will take any case of "TRUE" as True, while marking everything else as False; this is the same approach taken with genfromtxt when the dtype is given as bool. This will not fail for invalid true or false strings.
+static inline npy_int8
+AK_points_to_bool(int kind, const Py_UCS1 *data, Py_ssize_t len) {
+    // must have at least 4 characters
+    if (len < 4) {
+        return 0;
+    }
+    Py_ssize_t pos = 0;
+    Py_ssize_t end = 4; // we must have at least 4 characters for True
+    int i = 0;
+    Py_UCS4 c;
+
+    while (AK_is_space(PyUnicode_READ(kind, data, pos))) pos++;
+
+    for (;pos < end; ++pos) {
+        c = PyUnicode_READ(kind, data, pos);
+        if (c == (Py_UCS4)TRUE_LOWER[i] || c == (Py_UCS4)TRUE_UPPER[i]) {
+            ++i;
+        }
+        else {
+            return 0;
+        }
+    }
+    return 1; //matched all characters
+}
+
+// NOTE: using PyOS_strtol was an alternative, but needed to be passed a null-terminated char, which would require copying the data out of the CPL. This approach reads directly from the CPL without copying.
+static inline npy_int64
+AK_points_to_int64(int kind, Py_UCS1 *p, Py_ssize_t len, int *error, char tsep)
+{
+    if (kind != PyUnicode_1BYTE_KIND) { // cannot be an integer
+        *error = 1;
+        return 0;
+    }
+    return AK_UCS1_to_int64(p, p + len, error, tsep);
+}
+
+// Convert a field to a float64; sets `error` on failure.
+static inline npy_float64
+AK_points_to_float64(int kind, Py_UCS1 *p, Py_ssize_t len, int *error, char tsep, char decc)
+{
+    // interpret an empty field as NaN
+    if (len == 0) {
+        return NPY_NAN;
+    }
+    if (kind != PyUnicode_1BYTE_KIND) { // cannot be a float
+        *error = 1;
+        return 0;
+    }
+    return AK_UCS1_to_float64(p, p + len, error, tsep, decc);
+}
+
+//------------------------------------------------------------------------------
+// CodePointLine
+
+// An AK_CodePointLine stores a contiguous buffer of code points without null terminators between fields. As with PyUnicode objects, code points are stored in units of 1, 2, or 4 bytes, given by `kind`; the buffer starts with 1-byte units and is widened only when a wider code point is added. Separately, we store an array of offsets, where each offset is the cumulative end of a field in code points, such that any field can be found without reading the fields before it. Offsets are stored as 32-bit unsigned integers, and are widened to Py_ssize_t only when the buffer exceeds AK_CPL_OFFSET_NARROW_MAX (UINT32_MAX) code points. The total number of fields is given by offset_count.
+typedef struct AK_CodePointLine{
+    // NOTE: should these be unsigned int types, like Py_uintptr_t?
+    Py_ssize_t buffer_count; // accumulated number of code points
+    Py_ssize_t buffer_capacity; // max number of code points
+    int kind; // PyUnicode_1BYTE_KIND, PyUnicode_2BYTE_KIND, or PyUnicode_4BYTE_KIND
+    Py_UCS1 *buffer; // addressed in bytes
+
+    Py_ssize_t offsets_count; // accumulated number of elements, never reset
     Py_ssize_t offsets_capacity; // max number of elements
-    Py_ssize_t *offsets;
-    Py_ssize_t offset_max; // observe max offset found across all
+    void *offsets; // npy_uint32, or Py_ssize_t if offsets_wide
+    bool offsets_wide;
+    Py_ssize_t offset_max; // observe max field length found across all
 
     // these can be reset
-    Py_UCS4 *buffer_current_ptr;
+    Py_UCS1 *buffer_current_ptr;
     Py_ssize_t offsets_current_index;
 
     AK_TypeParser *type_parser;
     bool type_parser_field_active;
     bool type_parser_line_active;
 
+    const AK_NAValues *na_values; // NULL, or borrowed tokens stored as empty fields
+    bool na_found; // a field matched an NA value
+
+    // only type parse: offsets are counted but not stored, and points are only retained for the current field when needed to match NA values or to find a datetime unit
+    bool discard;
+    // with discard, for a line of a given datetime dtype without a unit, the finest unit of its fields as found by AK_CPL_datetime_unit (NPY_FR_GENERIC if all are NaT, or -1 if any could not be interpreted); otherwise AK_CPL_DT_UNIT_UNTRACKED
+    int dt_unit;
+
+    // with a dtype known when the line is created, 'i' (int64), 'f' (float64), or 'b' (bool): each field is converted when closed into `values`; offsets are counted but not stored, and points are only retained for the current field
+    char typed;
+    char *values;
+    Py_ssize_t values_capacity; // in elements
+    int typed_error; // set if a field could not be converted
+    char tsep;
+    char decc;
+
 } AK_CodePointLine;
 
-// Returns NULL on error.
+# define AK_CPL_DT_UNIT_UNTRACKED -2
+
+// The largest offset stored before offsets are widened; only lowered to test widening.
+# ifndef AK_CPL_OFFSET_NARROW_MAX
+# define AK_CPL_OFFSET_NARROW_MAX UINT32_MAX
+# endif
+
+// Return the end of field `i` in code points.
+static inline Py_ssize_t
+AK_CPL_offset(const AK_CodePointLine* cpl, Py_ssize_t i)
+{
+    if (AK_LIKELY(!cpl->offsets_wide)) return ((npy_uint32*)cpl->offsets)[i];
+    return ((Py_ssize_t*)cpl->offsets)[i];
+}
+
+// Return the start of field `i` in code points.
+static inline Py_ssize_t
+AK_CPL_field_start(const AK_CodePointLine* cpl, Py_ssize_t i)
+{
+    return i > 0 ? AK_CPL_offset(cpl, i - 1) : 0;
+}
+
+// Return the length of field `i` in code points.
+static inline Py_ssize_t
+AK_CPL_field_len(const AK_CodePointLine* cpl, Py_ssize_t i)
+{
+    return AK_CPL_offset(cpl, i) - AK_CPL_field_start(cpl, i);
+}
+
+// Return a pointer to the first code point of field `i`.
+static inline Py_UCS1*
+AK_CPL_field_ptr(const AK_CodePointLine* cpl, Py_ssize_t i)
+{
+    return cpl->buffer + AK_CPL_field_start(cpl, i) * cpl->kind;
+}
+
+// Initial capacities for a CPL that is expected to hold many fields, as when loading an iterable of strings.
+#define AK_CPL_BUFFER_CAPACITY 16384
+#define AK_CPL_OFFSETS_CAPACITY 2048
+// Minimum capacities for a CPL sized from an expected count.
+#define AK_CPL_BUFFER_CAPACITY_MIN 64
+#define AK_CPL_OFFSETS_CAPACITY_MIN 8
+
+// Return the smallest power-of-two multiple of `minimum` that exceeds `count`.
+static inline Py_ssize_t
+AK_CPL_capacity(Py_ssize_t count, Py_ssize_t minimum)
+{
+    Py_ssize_t capacity = minimum;
+    while (capacity <= count) capacity <<= 1;
+    return capacity;
+}
+
+// Returns NULL on memory failure without setting an exception. CPLs are created and grown while tokenizing, which might be done on threads without the GIL; for this reason all CPL memory is managed with the PyMem_Raw interface. Capacities are given in code points and fields, and must be greater than zero.
 AK_CodePointLine*
-AK_CPL_New(bool type_parse, Py_UCS4 tsep, Py_UCS4 decc)
+AK_CPL_New(bool type_parse,
+        Py_UCS4 tsep,
+        Py_UCS4 decc,
+        Py_ssize_t buffer_capacity,
+        Py_ssize_t offsets_capacity)
 {
-    AK_CodePointLine *cpl = (AK_CodePointLine*)PyMem_Malloc(sizeof(AK_CodePointLine));
-    if (cpl == NULL) return (AK_CodePointLine*)PyErr_NoMemory();
+    AK_CodePointLine *cpl = (AK_CodePointLine*)PyMem_RawMalloc(sizeof(AK_CodePointLine));
+    if (cpl == NULL) return NULL;
 
     cpl->buffer_count = 0;
-    cpl->buffer_capacity =  16384; // 2048;
-    cpl->buffer = (Py_UCS4*)PyMem_Malloc(UCS4_SIZE * cpl->buffer_capacity);
+    cpl->buffer_capacity = buffer_capacity;
+    cpl->kind = PyUnicode_1BYTE_KIND;
+    cpl->buffer = (Py_UCS1*)PyMem_RawMalloc(cpl->buffer_capacity);
     if (cpl->buffer == NULL) {
-        PyMem_Free(cpl);
-        return (AK_CodePointLine*)PyErr_NoMemory();
+        PyMem_RawFree(cpl);
+        return NULL;
     }
     cpl->offsets_count = 0;
-    cpl->offsets_capacity = 2048; // 16384; // 2048;
-    cpl->offsets = (Py_ssize_t*)PyMem_Malloc(sizeof(Py_ssize_t) * cpl->offsets_capacity);
+    cpl->offsets_capacity = offsets_capacity;
+    cpl->offsets = PyMem_RawMalloc(sizeof(npy_uint32) * cpl->offsets_capacity);
+    cpl->offsets_wide = false;
     if (cpl->offsets == NULL) {
-        PyMem_Free(cpl->buffer);
-        PyMem_Free(cpl);
-        return (AK_CodePointLine*)PyErr_NoMemory();
+        PyMem_RawFree(cpl->buffer);
+        PyMem_RawFree(cpl);
+        return NULL;
     }
     cpl->buffer_current_ptr = cpl->buffer;
     cpl->offsets_current_index = 0; // position in offsets
     cpl->offset_max = 0;
+    cpl->na_values = NULL;
+    cpl->na_found = false;
+    cpl->discard = false;
+    cpl->dt_unit = AK_CPL_DT_UNIT_UNTRACKED;
+    cpl->typed = '\0';
+    cpl->values = NULL;
+    cpl->values_capacity = 0;
+    cpl->typed_error = 0;
+    cpl->tsep = (char)tsep;
+    cpl->decc = (char)decc;
 
     // optional, dynamic values
     if (type_parse) {
         cpl->type_parser = AK_TP_New(tsep, decc);
         if (cpl->type_parser == NULL) {
-            PyMem_Free(cpl->offsets);
-            PyMem_Free(cpl->buffer);
-            PyMem_Free(cpl);
-            return NULL; // exception already set
+            PyMem_RawFree(cpl->offsets);
+            PyMem_RawFree(cpl->buffer);
+            PyMem_RawFree(cpl);
+            return NULL;
         }
         cpl->type_parser_field_active = true;
         cpl->type_parser_line_active = true;
@@ -1289,12 +3094,54 @@ AK_CPL_New(bool type_parse, Py_UCS4 tsep, Py_UCS4 decc)
 void
 AK_CPL_Free(AK_CodePointLine* cpl)
 {
-    PyMem_Free(cpl->buffer);
-    PyMem_Free(cpl->offsets);
+    PyMem_RawFree(cpl->buffer);
+    PyMem_RawFree(cpl->offsets);
+    PyMem_RawFree(cpl->values);
     if (cpl->type_parser) {
-        PyMem_Free(cpl->type_parser);
+        AK_TP_Free(cpl->type_parser);
+    }
+    PyMem_RawFree(cpl);
+}
+
+// Clear all fields such that the CPL can be reused, retaining allocated capacity. A widened buffer is reset to 1-byte units, using the same allocation. Returns 0 on success, -1 on memory failure without setting an exception.
+static int
+AK_CPL_Reset(AK_CodePointLine* cpl, bool type_parse, Py_UCS4 tsep, Py_UCS4 decc)
+{
+    cpl->buffer_capacity *= cpl->kind;
+    cpl->kind = PyUnicode_1BYTE_KIND;
+    cpl->buffer_count = 0;
+    cpl->buffer_current_ptr = cpl->buffer;
+    cpl->offsets_count = 0;
+    cpl->offsets_current_index = 0;
+    cpl->offset_max = 0;
+    // wide offsets are reset to narrow, retaining the larger allocation for widening again
+    cpl->offsets_wide = false;
+    cpl->na_found = false;
+    cpl->dt_unit = AK_CPL_DT_UNIT_UNTRACKED;
+    cpl->typed = '\0';
+    cpl->typed_error = 0;
+
+    if (type_parse) {
+        if (cpl->type_parser == NULL) {
+            cpl->type_parser = AK_TP_New(tsep, decc);
+            if (cpl->type_parser == NULL) return -1;
+        }
+        else {
+            AK_TP_reset_field(cpl->type_parser);
+            AK_TP_reset_line(cpl->type_parser);
+        }
+        cpl->type_parser_field_active = true;
+        cpl->type_parser_line_active = true;
+    }
+    else {
+        if (cpl->type_parser) {
+            AK_TP_Free(cpl->type_parser);
+            cpl->type_parser = NULL;
+        }
+        cpl->type_parser_field_active = false;
+        cpl->type_parser_line_active = false;
     }
-    PyMem_Free(cpl);
+    return 0;
 }
 
 //------------------------------------------------------------------------------
@@ -1308,16 +3155,39 @@ AK_CPL_resize_buffer(AK_CodePointLine* cpl, Py_ssize_t increment) {
         while (cpl->buffer_capacity < target) {
             cpl->buffer_capacity <<= 1;
         }
-        cpl->buffer = PyMem_Realloc(cpl->buffer,
-                UCS4_SIZE * cpl->buffer_capacity);
+        cpl->buffer = PyMem_RawRealloc(cpl->buffer,
+                cpl->kind * cpl->buffer_capacity);
         if (cpl->buffer == NULL) {
             return -1;
         }
-        cpl->buffer_current_ptr = cpl->buffer + cpl->buffer_count;
+        cpl->buffer_current_ptr = cpl->buffer + cpl->buffer_count * cpl->kind;
     }
     return 0;
 }
 
+// Widen the buffer to store code points of `kind`, which must be greater than the current kind. Returns 0 on success, -1 on failure.
+static int
+AK_CPL_widen(AK_CodePointLine* cpl, int kind) {
+    Py_UCS1 *buffer = PyMem_RawRealloc(cpl->buffer, kind * cpl->buffer_capacity);
+    if (buffer == NULL) return -1;
+    // convert in place from the end, as each wider unit only overwrites units already converted
+    for (Py_ssize_t i = cpl->buffer_count - 1; i >= 0; --i) {
+        PyUnicode_WRITE(kind, buffer, i, PyUnicode_READ(cpl->kind, buffer, i));
+    }
+    cpl->buffer = buffer;
+    cpl->kind = kind;
+    cpl->buffer_current_ptr = buffer + cpl->buffer_count * kind;
+    return 0;
+}
+
+// Return the minimum kind needed to store the code point.
+static inline int
+AK_UCS4_kind(Py_UCS4 c) {
+    if (c < 0x100) return PyUnicode_1BYTE_KIND;
+    if (c < 0x10000) return PyUnicode_2BYTE_KIND;
+    return PyUnicode_4BYTE_KIND;
+}
+
 
 // NOTE: we only add one offset at time, so this does not need to take an increment argument.
 static inline int
@@ -1326,8 +3196,9 @@ AK_CPL_resize_offsets(AK_CodePointLine* cpl) {
     if (AK_UNLIKELY(cpl->offsets_count == cpl->offsets_capacity)) {
         // realloc
         cpl->offsets_capacity <<= 1;
-        cpl->offsets = PyMem_Realloc(cpl->offsets,
-                sizeof(Py_ssize_t) * cpl->offsets_capacity);
+        cpl->offsets = PyMem_RawRealloc(cpl->offsets,
+                (cpl->offsets_wide ? sizeof(Py_ssize_t) : sizeof(npy_uint32))
+                * cpl->offsets_capacity);
         if (cpl->offsets == NULL) {
             return -1;
         }
@@ -1335,6 +3206,34 @@ AK_CPL_resize_offsets(AK_CodePointLine* cpl) {
     return 0;
 }
 
+// Widen offsets to Py_ssize_t, as needed once the buffer exceeds UINT32_MAX code points. Returns 0 on success, -1 on failure.
+static int
+AK_CPL_widen_offsets(AK_CodePointLine* cpl) {
+    void *offsets = PyMem_RawRealloc(cpl->offsets, sizeof(Py_ssize_t) * cpl->offsets_capacity);
+    if (offsets == NULL) return -1;
+    // convert in place from the end, as each wider offset only overwrites offsets already converted
+    for (Py_ssize_t i = cpl->offsets_count - 1; i >= 0; --i) {
+        ((Py_ssize_t*)offsets)[i] = ((npy_uint32*)offsets)[i];
+    }
+    cpl->offsets = offsets;
+    cpl->offsets_wide = true;
+    return 0;
+}
+
+// Store `end`, the end of the next field in code points; offsets must have been resized to fit. Returns 0 on success, -1 on failure.
+static inline int
+AK_CPL_set_offset(AK_CodePointLine* cpl, Py_ssize_t end) {
+    if (AK_LIKELY(!cpl->offsets_wide)) {
+        if (AK_LIKELY(end <= AK_CPL_OFFSET_NARROW_MAX)) {
+            ((npy_uint32*)cpl->offsets)[cpl->offsets_count++] = (npy_uint32)end;
+            return 0;
+        }
+        if (AK_CPL_widen_offsets(cpl)) return -1;
+    }
+    ((Py_ssize_t*)cpl->offsets)[cpl->offsets_count++] = end;
+    return 0;
+}
+
 // Given a PyUnicode PyObject representing a complete field, load the string content into the CPL. Used for iterable_str_to_array_1d. Returns 0 on success, -1 on error.
 static inline int
 AK_CPL_AppendField(AK_CodePointLine* cpl, PyObject* field)
@@ -1344,31 +3243,45 @@ AK_CPL_AppendField(AK_CodePointLine* cpl, PyObject* field)
         return -1;
     }
     Py_ssize_t element_length = PyUnicode_GET_LENGTH(field);
+    int field_kind = PyUnicode_KIND(field);
+    const void *data = PyUnicode_DATA(field);
 
+    if (cpl->na_values && AK_NA_match(cpl->na_values, field_kind, data, element_length)) {
+        element_length = 0;
+        cpl->na_found = true;
+        if (cpl->type_parser) cpl->type_parser->line_na = true;
+    }
+
+    if (field_kind > cpl->kind && AK_CPL_widen(cpl, field_kind)) {
+        PyErr_NoMemory();
+        return -1;
+    }
     // if we cannot fit field length, resize
     if (AK_CPL_resize_buffer(cpl, element_length)) {
+        PyErr_NoMemory();
         return -1;
     }
 
     // we write the field directly into the CPL buffer
-    if(PyUnicode_AsUCS4(field,
-            cpl->buffer_current_ptr,
-            cpl->buffer + cpl->buffer_capacity - cpl->buffer_current_ptr,
-            0) == NULL) { // last zero means do not copy null
-        return -1;
+    if (field_kind == cpl->kind) {
+        memcpy(cpl->buffer_current_ptr, data, element_length * field_kind);
+    }
+    else {
+        for (Py_ssize_t i = 0; i < element_length; ++i) {
+            PyUnicode_WRITE(cpl->kind,
+                    cpl->buffer_current_ptr,
+                    i,
+                    PyUnicode_READ(field_kind, data, i));
+        }
     }
     // if type parsing has been enabled, we must process each char
     if (cpl->type_parser && cpl->type_parser_line_active) {
-        Py_UCS4* p = cpl->buffer_current_ptr;
-        Py_UCS4 *end = p + element_length;
-        Py_ssize_t pos = 0;
-        for (; p < end; ++p) {
+        for (Py_ssize_t pos = 0; pos < element_length; ++pos) {
             cpl->type_parser_field_active = AK_TP_ProcessChar(
                     cpl->type_parser,
-                    *p,
+                    PyUnicode_READ(field_kind, data, pos),
                     pos);
             if (!cpl->type_parser_field_active) break;
-            ++pos;
         }
         cpl->type_parser_line_active = AK_TP_ResolveLineResetField(cpl->type_parser, element_length);
         cpl->type_parser_field_active = true; // turn back on for next field
@@ -1376,9 +3289,9 @@ AK_CPL_AppendField(AK_CodePointLine* cpl, PyObject* field)
 
     // read offset_count, then increment
     if (AK_CPL_resize_offsets(cpl)) return -1;
-    cpl->offsets[cpl->offsets_count++] = element_length;
+    if (AK_CPL_set_offset(cpl, cpl->buffer_count + element_length)) return -1;
     cpl->buffer_count += element_length;
-    cpl->buffer_current_ptr += element_length; // add to pointer
+    cpl->buffer_current_ptr += element_length * cpl->kind; // add to pointer
 
     if (element_length > cpl->offset_max) {
         cpl->offset_max = element_length;
@@ -1392,9 +3305,6 @@ AK_CPL_AppendPoint(AK_CodePointLine* cpl,
         Py_UCS4 p,
         Py_ssize_t pos)
 {
-    // based on buffer_count, resize if we cannot fit one more character
-    if (AK_CPL_resize_buffer(cpl, 1)) return -1;
-
     // type_parser might not be active if we already know the dtype
     if (cpl->type_parser
             && cpl->type_parser_line_active
@@ -1404,61 +3314,278 @@ AK_CPL_AppendPoint(AK_CodePointLine* cpl,
                 p,
                 pos);
     }
-    *cpl->buffer_current_ptr++ = p;
+    if (AK_UNLIKELY(cpl->discard) && cpl->na_values == NULL
+            && cpl->dt_unit == AK_CPL_DT_UNIT_UNTRACKED) return 0;
+
+    // based on buffer_count, resize if we cannot fit one more character
+    if (AK_CPL_resize_buffer(cpl, 1)) return -1;
+    if (AK_UNLIKELY(p > 0xFF) && AK_UCS4_kind(p) > cpl->kind) {
+        if (AK_CPL_widen(cpl, AK_UCS4_kind(p))) return -1;
+    }
+    if (AK_LIKELY(cpl->kind == PyUnicode_1BYTE_KIND)) {
+        *cpl->buffer_current_ptr++ = (Py_UCS1)p;
+    }
+    else {
+        PyUnicode_WRITE(cpl->kind, cpl->buffer_current_ptr, 0, p);
+        cpl->buffer_current_ptr += cpl->kind;
+    }
     ++cpl->buffer_count;
     return 0;
 }
 
-// Append to offsets. This does not update buffer lines. This is called when closing a field. Return -1 on failure, 0 on success.
+// Add `count` ASCII points to a line, where `pos` is the position of the first point in the field. This does not update offsets. Returns 0 on success, -1 on error.
 static inline int
-AK_CPL_AppendOffset(AK_CodePointLine* cpl, Py_ssize_t offset)
+AK_CPL_AppendPoints(AK_CodePointLine* cpl,
+        const Py_UCS1 *p,
+        Py_ssize_t count,
+        Py_ssize_t pos)
 {
-    // this will update cpl->offsets if necessary
-    if (AK_CPL_resize_offsets(cpl)) return -1;
-
-    if (cpl->type_parser && cpl->type_parser_line_active) {
-        // when we resolve the line, we might determine that no further line processing is necessary
-        cpl->type_parser_line_active = AK_TP_ResolveLineResetField(
-                cpl->type_parser,
-                offset);
+    if (cpl->type_parser
+            && cpl->type_parser_line_active
+            && cpl->type_parser_field_active) {
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            if (!AK_TP_ProcessChar(cpl->type_parser, p[i], pos + i)) {
+                cpl->type_parser_field_active = false;
+                break;
+            }
+        }
+    }
+    if (AK_UNLIKELY(cpl->discard) && cpl->na_values == NULL
+            && cpl->dt_unit == AK_CPL_DT_UNIT_UNTRACKED) return 0;
+
+    if (AK_CPL_resize_buffer(cpl, count)) return -1;
+    if (AK_LIKELY(cpl->kind == PyUnicode_1BYTE_KIND)) {
+        memcpy(cpl->buffer_current_ptr, p, count);
+    }
+    else {
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            PyUnicode_WRITE(cpl->kind, cpl->buffer_current_ptr, i, p[i]);
+        }
+    }
+    cpl->buffer_current_ptr += count * cpl->kind;
+    cpl->buffer_count += count;
+    return 0;
+}
+
+// Return the kind of typed CPL to be used for a line of `dtype`, or '\0' if the dtype is not one converted while tokenizing.
+static inline char
+AK_CPL_typed_kind(PyArray_Descr* dtype)
+{
+    if (!PyArray_ISNBO(dtype->byteorder)) return '\0';
+    if (dtype->kind == 'b') return 'b';
+    if ((dtype->kind == 'i' || dtype->kind == 'f') && dtype->elsize == 8) return dtype->kind;
+    return '\0';
+}
+
+// For a typed CPL, convert the field of `offset` points that ends at the current position into `values`, then remove its points. Returns 0 on success, -1 on memory failure; conversion failures are recorded in `typed_error`.
+static inline int
+AK_CPL_typed_append(AK_CodePointLine* cpl, Py_ssize_t offset)
+{
+    if (AK_UNLIKELY(cpl->offsets_count == cpl->values_capacity)) {
+        Py_ssize_t capacity = cpl->values_capacity ? cpl->values_capacity << 1 : cpl->offsets_capacity;
+        char *values = PyMem_RawRealloc(cpl->values,
+                (cpl->typed == 'b' ? 1 : 8) * capacity);
+        if (values == NULL) return -1;
+        cpl->values = values;
+        cpl->values_capacity = capacity;
+    }
+    Py_UCS1 *p = cpl->buffer_current_ptr - offset * cpl->kind;
+    switch (cpl->typed) {
+        case 'i':
+            ((npy_int64*)cpl->values)[cpl->offsets_count] = AK_points_to_int64(
+                    cpl->kind, p, offset, &cpl->typed_error, cpl->tsep);
+            break;
+        case 'f':
+            ((npy_float64*)cpl->values)[cpl->offsets_count] = AK_points_to_float64(
+                    cpl->kind, p, offset, &cpl->typed_error, cpl->tsep, cpl->decc);
+            break;
+        case 'b':
+            ((npy_bool*)cpl->values)[cpl->offsets_count] = AK_points_to_bool(
+                    cpl->kind, p, offset);
+            break;
+    }
+    cpl->buffer_current_ptr = cpl->buffer;
+    cpl->buffer_count = 0;
+    ++cpl->offsets_count;
+    return 0;
+}
+
+// For a line finding a datetime unit while discarding, include the unit of the field of `offset` points that ends at the current position, as AK_CPL_datetime_unit does.
+static inline void
+AK_CPL_discard_datetime(AK_CodePointLine* cpl, Py_ssize_t offset)
+{
+    AK_Datetime dt;
+    Py_UCS1 *p = cpl->buffer_current_ptr - offset * cpl->kind;
+    if (cpl->kind != PyUnicode_1BYTE_KIND || AK_UCS1_to_datetime(p, p + offset, &dt)) {
+        cpl->dt_unit = -1;
+    }
+    else if (dt.unit != NPY_FR_GENERIC
+            && (cpl->dt_unit == NPY_FR_GENERIC || (int)dt.unit > cpl->dt_unit)) {
+        cpl->dt_unit = dt.unit;
+    }
+}
+
+// Append to offsets. This does not update buffer lines. This is called when closing a field. Return -1 on failure, 0 on success.
+static inline int
+AK_CPL_AppendOffset(AK_CodePointLine* cpl, Py_ssize_t offset)
+{
+    // this will update cpl->offsets if necessary
+    if (!cpl->discard && !cpl->typed && AK_CPL_resize_offsets(cpl)) return -1;
+
+    if (cpl->na_values && AK_NA_match(cpl->na_values,
+            cpl->kind,
+            cpl->buffer_current_ptr - offset * cpl->kind,
+            offset)) {
+        // remove the field's points to store it as an empty field
+        cpl->buffer_current_ptr -= offset * cpl->kind;
+        cpl->buffer_count -= offset;
+        offset = 0;
+        cpl->na_found = true;
+        if (cpl->type_parser) cpl->type_parser->line_na = true;
+    }
+
+    if (cpl->type_parser && cpl->type_parser_line_active) {
+        // when we resolve the line, we might determine that no further line processing is necessary
+        cpl->type_parser_line_active = AK_TP_ResolveLineResetField(
+                cpl->type_parser,
+                offset);
         // NOTE: always turn on for next field; we choose not to check type_parser_line_active
         cpl->type_parser_field_active = true;
     }
-    // increment offset_count after assignment so we can grow if needed next time
-    cpl->offsets[cpl->offsets_count++] = offset;
+    if (AK_UNLIKELY(cpl->discard)) {
+        if (cpl->dt_unit >= 0) AK_CPL_discard_datetime(cpl, offset);
+        cpl->buffer_current_ptr = cpl->buffer;
+        cpl->buffer_count = 0;
+        ++cpl->offsets_count;
+    }
+    else if (cpl->typed) {
+        if (AK_CPL_typed_append(cpl, offset)) return -1;
+    }
+    else {
+        // the field's points are already counted in buffer_count
+        if (AK_CPL_set_offset(cpl, cpl->buffer_count)) return -1;
+    }
     if (offset > cpl->offset_max) {
         cpl->offset_max = offset;
     }
     return 0;
 }
 
+// Append all fields of `other` to `cpl`, as if they had been loaded into `cpl` after its own fields; both CPLs must have completed all fields. If both have type parsers, the resolved line types are combined. `other` is not modified. Does not require the GIL. Returns 0 on success, -1 on memory failure without setting an exception; on failure, `cpl` is unchanged.
+static int
+AK_CPL_Extend(AK_CodePointLine* cpl, AK_CodePointLine* other)
+{
+    if (cpl->typed) {
+        // lines of the same position have the same dtype, and only converted values are retained
+        Py_ssize_t size = cpl->typed == 'b' ? 1 : 8;
+        Py_ssize_t count = cpl->offsets_count + other->offsets_count;
+        if (count > cpl->values_capacity) {
+            char *values = PyMem_RawRealloc(cpl->values, size * count);
+            if (values == NULL) return -1;
+            cpl->values = values;
+            cpl->values_capacity = count;
+        }
+        if (other->offsets_count) {
+            memcpy(cpl->values + size * cpl->offsets_count, other->values, size * other->offsets_count);
+        }
+        cpl->offsets_count = count;
+        cpl->typed_error |= other->typed_error;
+        cpl->na_found |= other->na_found;
+        if (other->offset_max > cpl->offset_max) {
+            cpl->offset_max = other->offset_max;
+        }
+        return 0;
+    }
+    if (other->kind > cpl->kind && AK_CPL_widen(cpl, other->kind)) return -1;
+
+    Py_ssize_t buffer_count = cpl->buffer_count + other->buffer_count;
+    if (buffer_count > cpl->buffer_capacity) {
+        Py_UCS1 *buffer = PyMem_RawRealloc(cpl->buffer, cpl->kind * buffer_count);
+        if (buffer == NULL) return -1;
+        cpl->buffer = buffer;
+        cpl->buffer_capacity = buffer_count;
+    }
+    Py_ssize_t offsets_count = cpl->offsets_count + other->offsets_count;
+    if (offsets_count > cpl->offsets_capacity) {
+        void *offsets = PyMem_RawRealloc(cpl->offsets,
+                (cpl->offsets_wide ? sizeof(Py_ssize_t) : sizeof(npy_uint32)) * offsets_count);
+        if (offsets == NULL) return -1;
+        cpl->offsets = offsets;
+        cpl->offsets_capacity = offsets_count;
+    }
+    if (!cpl->offsets_wide && buffer_count > AK_CPL_OFFSET_NARROW_MAX && AK_CPL_widen_offsets(cpl)) return -1;
+    if (other->kind == cpl->kind) {
+        memcpy(cpl->buffer + cpl->buffer_count * cpl->kind,
+                other->buffer,
+                other->kind * other->buffer_count);
+    }
+    else {
+        Py_UCS1 *dst = cpl->buffer + cpl->buffer_count * cpl->kind;
+        for (Py_ssize_t i = 0; i < other->buffer_count; ++i) {
+            PyUnicode_WRITE(cpl->kind, dst, i, PyUnicode_READ(other->kind, other->buffer, i));
+        }
+    }
+    // offsets of `other` are shifted by the points already in `cpl`
+    Py_ssize_t shift = cpl->buffer_count;
+    for (Py_ssize_t i = 0; i < other->offsets_count; ++i) {
+        AK_CPL_set_offset(cpl, shift + AK_CPL_offset(other, i)); // cannot fail, as widened above
+    }
+    cpl->buffer_count = buffer_count;
+    cpl->buffer_current_ptr = cpl->buffer + buffer_count * cpl->kind;
+
+    if (other->offset_max > cpl->offset_max) {
+        cpl->offset_max = other->offset_max;
+    }
+    cpl->na_found |= other->na_found;
+    // a parsed_line of TPS_UNKNOWN means no fields were resolved
+    if (cpl->type_parser
+            && other->type_parser
+            && other->type_parser->parsed_line != TPS_UNKNOWN) {
+        AK_TP_ExtendLine(cpl->type_parser, other->type_parser);
+        cpl->type_parser_line_active = cpl->type_parser->parsed_line != TPS_STRING;
+    }
+    return 0;
+}
+
 //------------------------------------------------------------------------------
 // CodePointLine: Constructors
 
-// Given an iterable of unicode objects, load them into a AK_CodePointLine. Used for iterable_str_to_array_1d. Return NULL on error.
+// Given an iterable of unicode objects, load them into a AK_CodePointLine. Used for iterable_str_to_array_1d. `na_values` can be NULL, and must outlive the CPL. Return NULL on error.
 AK_CodePointLine*
-AK_CPL_FromIterable(PyObject* iterable, bool type_parse, Py_UCS4 tsep, Py_UCS4 decc)
+AK_CPL_FromIterable(PyObject* iterable,
+        bool type_parse,
+        Py_UCS4 tsep,
+        Py_UCS4 decc,
+        const AK_NAValues *na_values)
 {
     PyObject *iter = PyObject_GetIter(iterable);
     if (iter == NULL) return NULL;
 
-    AK_CodePointLine *cpl = AK_CPL_New(type_parse, tsep, decc);
+    AK_CodePointLine *cpl = AK_CPL_New(type_parse,
+            tsep,
+            decc,
+            AK_CPL_BUFFER_CAPACITY,
+            AK_CPL_OFFSETS_CAPACITY);
     if (cpl == NULL) {
         Py_DECREF(iter);
+        PyErr_NoMemory();
         return NULL;
     }
+    cpl->na_values = na_values;
 
     PyObject *field;
     while ((field = PyIter_Next(iter))) {
         if (AK_CPL_AppendField(cpl, field)) {
             Py_DECREF(field);
             Py_DECREF(iter);
+            AK_CPL_Free(cpl);
             return NULL;
         }
         Py_DECREF(field);
     }
     Py_DECREF(iter);
     if (PyErr_Occurred()) {
+        AK_CPL_Free(cpl);
         return NULL;
     }
     return cpl;
@@ -1480,64 +3607,88 @@ static inline void
 AK_CPL_CurrentAdvance(AK_CodePointLine* cpl)
 {
     // use offsets_current_index, then increment
-    cpl->buffer_current_ptr += cpl->offsets[cpl->offsets_current_index++];
+    cpl->buffer_current_ptr = cpl->buffer + AK_CPL_offset(cpl, cpl->offsets_current_index++) * cpl->kind;
+}
+
+// Return the length of the current field in code points. Cannot error.
+static inline Py_ssize_t
+AK_CPL_current_len(AK_CodePointLine* cpl)
+{
+    return AK_CPL_field_len(cpl, cpl->offsets_current_index);
 }
 
 //------------------------------------------------------------------------------
-// This will take any case of "TRUE" as True, while marking everything else as False; this is the same approach taken with genfromtxt when the dtype is given as bool. This will not fail for invalid true or false strings.
 static inline npy_int8
 AK_CPL_current_to_bool(AK_CodePointLine* cpl) {
-    // must have at least 4 characters
-    if (cpl->offsets[cpl->offsets_current_index] < 4) {
-        return 0;
-    }
-    Py_UCS4 *p = cpl->buffer_current_ptr;
-    Py_UCS4 *end = p + 4; // we must have at least 4 characters for True
-    int i = 0;
-    char c;
-
-    while (AK_is_space(*p)) p++;
-
-    for (;p < end; ++p) {
-        c = *p;
-        if (c == TRUE_LOWER[i] || c == TRUE_UPPER[i]) {
-            ++i;
-        }
-        else {
-            return 0;
-        }
-    }
-    return 1; //matched all characters
+    return AK_points_to_bool(cpl->kind,
+            cpl->buffer_current_ptr,
+            AK_CPL_current_len(cpl));
 }
 
-// NOTE: using PyOS_strtol was an alternative, but needed to be passed a null-terminated char, which would require copying the data out of the CPL. This approach reads directly from the CPL without copying.
 static inline npy_int64
 AK_CPL_current_to_int64(AK_CodePointLine* cpl, int *error, char tsep)
 {
-    Py_UCS4 *p = cpl->buffer_current_ptr;
-    Py_UCS4 *end = p + cpl->offsets[cpl->offsets_current_index]; // size is either 4 or 5
-    return AK_UCS4_to_int64(p, end, error, tsep);
+    return AK_points_to_int64(cpl->kind,
+            cpl->buffer_current_ptr,
+            AK_CPL_current_len(cpl),
+            error,
+            tsep);
 }
 
 // Provide start and end buffer positions to provide a range of bytes to read and transform into an integer. Returns 0 on error; does not set exception.
 static inline npy_uint64
 AK_CPL_current_to_uint64(AK_CodePointLine* cpl, int *error, char tsep)
 {
-    Py_UCS4 *p = cpl->buffer_current_ptr;
-    Py_UCS4 *end = p + cpl->offsets[cpl->offsets_current_index];
-    return AK_UCS4_to_uint64(p, end, error, tsep);
+    if (cpl->kind != PyUnicode_1BYTE_KIND) { // cannot be an integer
+        *error = 1;
+        return 0;
+    }
+    Py_UCS1 *p = cpl->buffer_current_ptr;
+    Py_UCS1 *end = p + AK_CPL_current_len(cpl);
+    return AK_UCS1_to_uint64(p, end, error, tsep);
 }
 
 static inline npy_float64
 AK_CPL_current_to_float64(AK_CodePointLine* cpl, int *error, char tsep, char decc)
 {
-    // interpret an empty field as NaN
-    if (cpl->offsets[cpl->offsets_current_index] == 0) {
-        return NPY_NAN;
+    return AK_points_to_float64(cpl->kind,
+            cpl->buffer_current_ptr,
+            AK_CPL_current_len(cpl),
+            error,
+            tsep,
+            decc);
+}
+
+// Returns 0 on success, -1 if the field could not be interpreted as a complex. With NA values, which are stored as empty fields, an empty field is NaN.
+static inline int
+AK_CPL_current_to_complex(AK_CodePointLine* cpl,
+        char decc,
+        npy_float64 *real,
+        npy_float64 *imag)
+{
+    if (cpl->na_values && AK_CPL_current_len(cpl) == 0) {
+        *real = NPY_NAN;
+        *imag = NPY_NAN;
+        return 0;
+    }
+    if (cpl->kind != PyUnicode_1BYTE_KIND) {
+        return -1;
+    }
+    Py_UCS1 *p = cpl->buffer_current_ptr;
+    Py_UCS1 *end = p + AK_CPL_current_len(cpl);
+    return AK_UCS1_to_complex(p, end, decc, real, imag);
+}
+
+// Returns 0 on success, -1 if the field could not be interpreted as a datetime.
+static inline int
+AK_CPL_current_to_datetime(AK_CodePointLine* cpl, AK_Datetime *dt)
+{
+    if (cpl->kind != PyUnicode_1BYTE_KIND) {
+        return -1;
     }
-    Py_UCS4 *p = cpl->buffer_current_ptr;
-    Py_UCS4 *end = p + cpl->offsets[cpl->offsets_current_index];
-    return AK_UCS4_to_float64(p, end, error, tsep, decc);
+    Py_UCS1 *p = cpl->buffer_current_ptr;
+    Py_UCS1 *end = p + AK_CPL_current_len(cpl);
+    return AK_UCS1_to_datetime(p, end, dt);
 }
 
 
@@ -1546,7 +3697,7 @@ AK_CPL_current_to_float64(AK_CodePointLine* cpl, int *error, char tsep, char dec
 // AK_CPL_current_to_float64(AK_CodePointLine* cpl)
 // {
 //     // interpret an empty field as NaN
-//     if (cpl->offsets[cpl->offsets_current_index] == 0) {
+//     if (AK_CPL_current_len(cpl) == 0) {
 //         return NPY_NAN;
 //     }
 //     char* field = AK_CPL_current_to_field(cpl);
@@ -1559,22 +3710,87 @@ AK_CPL_current_to_float64(AK_CodePointLine* cpl, int *error, char tsep, char dec
 //------------------------------------------------------------------------------
 // CodePointLine: Exporters
 
+// Conversion of a CPL to an array is done in three stages: the array is created (with the GIL) by AK_CPL_array_new, filled (without the GIL) by AK_CPL_array_fill, and checked (with the GIL) by AK_CPL_array_check. This permits filling many arrays on threads. Fill functions return 0 on success, 1 if a field could not be parsed, or -1 if the dtype's itemsize is not supported; they do not set exceptions.
+
+// Returns true if the dtype kind can be converted with AK_CPL_array_new and AK_CPL_array_fill.
+static inline bool
+AK_CPL_array_native(char kind)
+{
+    switch (kind) {
+        case 'b':
+        case 'i':
+        case 'u':
+        case 'f':
+        case 'U':
+        case 'S':
+        case 'M':
+        case 'c':
+            return true;
+    }
+    return false;
+}
+
+// Return the finest unit given by the CPL's datetime fields, NPY_FR_GENERIC if all fields are NaT, or -1 if any field could not be interpreted.
+static inline int
+AK_CPL_datetime_unit(AK_CodePointLine* cpl)
+{
+    AK_Datetime dt;
+    int unit = NPY_FR_GENERIC;
+
+    AK_CPL_CurrentReset(cpl);
+    for (Py_ssize_t i = 0; i < cpl->offsets_count; ++i) {
+        if (AK_CPL_current_to_datetime(cpl, &dt)) return -1;
+        if (dt.unit != NPY_FR_GENERIC && (unit == NPY_FR_GENERIC || (int)dt.unit > unit)) {
+            unit = dt.unit;
+        }
+        AK_CPL_CurrentAdvance(cpl);
+    }
+    return unit;
+}
+
+// Set the itemsize of a unicode or bytes dtype without one to fit the largest field; as NumPy does for empty strings, the itemsize is at least one character.
+static inline void
+AK_CPL_size_dtype(AK_CodePointLine* cpl, PyArray_Descr* dtype)
+{
+    Py_ssize_t points = cpl->offset_max > 0 ? cpl->offset_max : 1;
+    dtype->elsize = (int)(dtype->kind == 'U' ? points * UCS4_SIZE : points);
+}
+
+// Create an uninitialized (or zeroed) array for the CPL's fields. The dtype must be a fresh instance: for unicode and bytes dtypes without an itemsize, it is mutated to fit the largest field. Steals the dtype reference. Returns NULL on error.
 static inline PyObject*
-AK_CPL_to_array_bool(AK_CodePointLine* cpl, PyArray_Descr* dtype)
+AK_CPL_array_new(AK_CodePointLine* cpl, PyArray_Descr* dtype)
 {
     npy_intp dims[] = {cpl->offsets_count};
 
-    // initialize all values to False
-    PyObject *array = PyArray_Zeros(1, dims, dtype, 0); // steals dtype ref
-    if (array == NULL) {
-        // expected array to steal dtype reference
-        return NULL;
+    // If the dtype has an itemsize, we will only load that many code points; if not, we set the itemsize to the max observed code points via the CPL offset.
+    if ((dtype->kind == 'U' || dtype->kind == 'S') && dtype->elsize == 0) {
+        AK_CPL_size_dtype(cpl, dtype);
     }
+    else if (dtype->kind == 'M' && AK_datetime_meta(dtype)->base == NPY_FR_GENERIC) {
+        // as NumPy does, use the finest unit found; if a field cannot be interpreted, the unit remains generic and filling will fail
+        int unit;
+        NPY_BEGIN_THREADS_DEF;
+        NPY_BEGIN_THREADS;
+        unit = AK_CPL_datetime_unit(cpl);
+        NPY_END_THREADS;
+        if (unit >= 0) {
+            AK_datetime_meta(dtype)->base = (NPY_DATETIMEUNIT)unit;
+            AK_datetime_meta(dtype)->num = 1;
+        }
+    }
+    // NOTE: it is assumed (though not verified in some testing) that we need to get zeroed array for unicode and bytes as we might copy to the array with less than the full item size width; bool arrays are initialized to False
+    if (dtype->kind == 'U' || dtype->kind == 'S' || dtype->kind == 'b') {
+        return PyArray_Zeros(1, dims, dtype, 0); // steals dtype ref
+    }
+    // NOTE: empty preferred over zeros
+    return PyArray_Empty(1, dims, dtype, 0); // steals dtype ref
+}
 
-    npy_bool *array_buffer = (npy_bool*)PyArray_DATA((PyArrayObject*)array);
-
-    NPY_BEGIN_THREADS_DEF;
-    NPY_BEGIN_THREADS;
+// This will take any case of "TRUE" as True, while marking everything else as False; this is the same approach taken with genfromtxt when the dtype is given as bool. This will not fail for invalid true or false strings. The array must be zeroed.
+static inline int
+AK_CPL_fill_bool(AK_CodePointLine* cpl, PyArrayObject* array)
+{
+    npy_bool *array_buffer = (npy_bool*)PyArray_DATA(array);
 
     AK_CPL_CurrentReset(cpl);
     for (Py_ssize_t i=0; i < cpl->offsets_count; ++i) {
@@ -1584,365 +3800,390 @@ AK_CPL_to_array_bool(AK_CodePointLine* cpl, PyArray_Descr* dtype)
         }
         AK_CPL_CurrentAdvance(cpl);
     }
-    NPY_END_THREADS;
-
-    PyArray_CLEARFLAGS((PyArrayObject *)array, NPY_ARRAY_WRITEABLE);
-    return array;
+    return 0;
 }
 
-// Given a type of signed integer, return the corresponding array.
-static inline PyObject*
-AK_CPL_to_array_float(AK_CodePointLine* cpl, PyArray_Descr* dtype, char tsep, char decc)
+static inline int
+AK_CPL_fill_float(AK_CodePointLine* cpl, PyArrayObject* array, char tsep, char decc)
 {
     Py_ssize_t count = cpl->offsets_count;
-    npy_intp dims[] = {count};
-
-    // NOTE: empty preferred over zeros
-    PyObject *array = PyArray_Empty(1, dims, dtype, 0); // steals dtype ref
-    if (array == NULL) {
-        return NULL;
-    }
-
     // initialize error code to 0; only update on error.
     int error = 0;
-    bool matched_elsize = true;
-    int elsize = dtype->elsize;
-
-    NPY_BEGIN_THREADS_DEF;
-    NPY_BEGIN_THREADS;
 
     AK_CPL_CurrentReset(cpl);
 
-    if (elsize == 16) {
-        # ifdef PyFloat128ArrType_Type
-        npy_float128 *array_buffer = (npy_float128*)PyArray_DATA((PyArrayObject*)array);
-        npy_float128 *end = array_buffer + count;
-        while (array_buffer < end) {
-            // NOTE: cannot cast to npy_float128 here
-            *array_buffer++ = AK_CPL_current_to_float64(cpl, &error, tsep, decc);
-            AK_CPL_CurrentAdvance(cpl);
+    switch (PyArray_DESCR(array)->elsize) {
+        case 16: {
+            # ifdef PyFloat128ArrType_Type
+            npy_float128 *array_buffer = (npy_float128*)PyArray_DATA(array);
+            npy_float128 *end = array_buffer + count;
+            while (array_buffer < end) {
+                // NOTE: cannot cast to npy_float128 here
+                *array_buffer++ = AK_CPL_current_to_float64(cpl, &error, tsep, decc);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            # endif
+            break;
         }
-        # endif
-    }
-    else if (elsize == 8) {
-        npy_float64 *array_buffer = (npy_float64*)PyArray_DATA((PyArrayObject*)array);
-        npy_float64 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = AK_CPL_current_to_float64(cpl, &error, tsep, decc);
-            AK_CPL_CurrentAdvance(cpl);
+        case 8: {
+            npy_float64 *array_buffer = (npy_float64*)PyArray_DATA(array);
+            npy_float64 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = AK_CPL_current_to_float64(cpl, &error, tsep, decc);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 4) {
-        npy_float32 *array_buffer = (npy_float32*)PyArray_DATA((PyArrayObject*)array);
-        npy_float32 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_float32)AK_CPL_current_to_float64(cpl, &error, tsep, decc);
-            AK_CPL_CurrentAdvance(cpl);
+        case 4: {
+            npy_float32 *array_buffer = (npy_float32*)PyArray_DATA(array);
+            npy_float32 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_float32)AK_CPL_current_to_float64(cpl, &error, tsep, decc);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 2) {
-        npy_float16 *array_buffer = (npy_float16*)PyArray_DATA((PyArrayObject*)array);
-        npy_float16 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = npy_double_to_half(AK_CPL_current_to_float64(cpl, &error, tsep, decc));
-            AK_CPL_CurrentAdvance(cpl);
+        case 2: {
+            npy_float16 *array_buffer = (npy_float16*)PyArray_DATA(array);
+            npy_float16 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = npy_double_to_half(AK_CPL_current_to_float64(cpl, &error, tsep, decc));
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
+        default:
+            return -1;
     }
-    else {
-        matched_elsize = false;
-    }
-
-    NPY_END_THREADS;
-
-    if (!matched_elsize) {
-        PyErr_SetString(PyExc_TypeError, "cannot create array from itemsize");
-        Py_DECREF(array);
-        return NULL;
-    }
-    if (error) {
-        PyErr_SetString(PyExc_TypeError, "error parsing float");
-        Py_DECREF(array);
-        return NULL;
-     }
-
-    PyArray_CLEARFLAGS((PyArrayObject *)array, NPY_ARRAY_WRITEABLE);
-    return array;
+    return error ? 1 : 0;
 }
 
-// Given a type of signed integer, return the corresponding array.
-static inline PyObject*
-AK_CPL_to_array_int(AK_CodePointLine* cpl, PyArray_Descr* dtype, char tsep)
+static inline int
+AK_CPL_fill_int(AK_CodePointLine* cpl, PyArrayObject* array, char tsep)
 {
     Py_ssize_t count = cpl->offsets_count;
-    npy_intp dims[] = {count};
-
-    // NOTE: empty prefered over zeros
-    PyObject *array = PyArray_Empty(1, dims, dtype, 0); // steals dtype ref
-    if (array == NULL) {
-        return NULL;
-    }
     // initialize error code to 0; only update on error.
     int error = 0;
-    bool matched_elsize = true;
-    int elsize = dtype->elsize;
-
-    NPY_BEGIN_THREADS_DEF;
-    NPY_BEGIN_THREADS;
 
     AK_CPL_CurrentReset(cpl);
-    if (elsize == 8) {
-        npy_int64 *array_buffer = (npy_int64*)PyArray_DATA((PyArrayObject*)array);
-        npy_int64 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = AK_CPL_current_to_int64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+
+    switch (PyArray_DESCR(array)->elsize) {
+        case 8: {
+            npy_int64 *array_buffer = (npy_int64*)PyArray_DATA(array);
+            npy_int64 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = AK_CPL_current_to_int64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 4) {
-        npy_int32 *array_buffer = (npy_int32*)PyArray_DATA((PyArrayObject*)array);
-        npy_int32 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_int32)AK_CPL_current_to_int64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+        case 4: {
+            npy_int32 *array_buffer = (npy_int32*)PyArray_DATA(array);
+            npy_int32 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_int32)AK_CPL_current_to_int64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 2) {
-        npy_int16 *array_buffer = (npy_int16*)PyArray_DATA((PyArrayObject*)array);
-        npy_int16 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_int16)AK_CPL_current_to_int64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+        case 2: {
+            npy_int16 *array_buffer = (npy_int16*)PyArray_DATA(array);
+            npy_int16 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_int16)AK_CPL_current_to_int64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 1) {
-        npy_int8 *array_buffer = (npy_int8*)PyArray_DATA((PyArrayObject*)array);
-        npy_int8 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_int8)AK_CPL_current_to_int64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+        case 1: {
+            npy_int8 *array_buffer = (npy_int8*)PyArray_DATA(array);
+            npy_int8 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_int8)AK_CPL_current_to_int64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
+        default:
+            return -1;
     }
-    else {
-        matched_elsize = false;
-    }
-    NPY_END_THREADS;
-
-    if (!matched_elsize) {
-        PyErr_SetString(PyExc_TypeError, "cannot create array from integer itemsize");
-        Py_DECREF(array);
-        return NULL;
-    }
-    if (error) {
-        PyErr_SetString(PyExc_TypeError, "error parsing integer");
-        Py_DECREF(array);
-        return NULL;
-     }
-
-    PyArray_CLEARFLAGS((PyArrayObject *)array, NPY_ARRAY_WRITEABLE);
-    return array;
+    return error ? 1 : 0;
 }
 
-// Given a type of signed integer, return the corresponding array. Return NULL on error.
-static inline PyObject*
-AK_CPL_to_array_uint(AK_CodePointLine* cpl, PyArray_Descr* dtype, char tsep)
+static inline int
+AK_CPL_fill_uint(AK_CodePointLine* cpl, PyArrayObject* array, char tsep)
 {
     Py_ssize_t count = cpl->offsets_count;
-    npy_intp dims[] = {count};
-
-    // NOTE: empty prefered over zeros
-    PyObject *array = PyArray_Empty(1, dims, dtype, 0); // steals dtype ref
-    if (array == NULL) {
-        return NULL;
-    }
     // initialize error code to 0; only update on error.
     int error = 0;
-    bool matched_elsize = true;
-    int elsize = dtype->elsize;
-
-    NPY_BEGIN_THREADS_DEF;
-    NPY_BEGIN_THREADS;
 
     AK_CPL_CurrentReset(cpl);
-    if (elsize == 8) {
-        npy_uint64 *array_buffer = (npy_uint64*)PyArray_DATA((PyArrayObject*)array);
-        npy_uint64 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = AK_CPL_current_to_uint64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+
+    switch (PyArray_DESCR(array)->elsize) {
+        case 8: {
+            npy_uint64 *array_buffer = (npy_uint64*)PyArray_DATA(array);
+            npy_uint64 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = AK_CPL_current_to_uint64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 4) {
-        npy_uint32 *array_buffer = (npy_uint32*)PyArray_DATA((PyArrayObject*)array);
-        npy_uint32 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_uint32)AK_CPL_current_to_uint64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+        case 4: {
+            npy_uint32 *array_buffer = (npy_uint32*)PyArray_DATA(array);
+            npy_uint32 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_uint32)AK_CPL_current_to_uint64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 2) {
-        npy_uint16 *array_buffer = (npy_uint16*)PyArray_DATA((PyArrayObject*)array);
-        npy_uint16 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_uint16)AK_CPL_current_to_uint64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+        case 2: {
+            npy_uint16 *array_buffer = (npy_uint16*)PyArray_DATA(array);
+            npy_uint16 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_uint16)AK_CPL_current_to_uint64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
-    }
-    else if (elsize == 1) {
-        npy_uint8 *array_buffer = (npy_uint8*)PyArray_DATA((PyArrayObject*)array);
-        npy_uint8 *end = array_buffer + count;
-        while (array_buffer < end) {
-            *array_buffer++ = (npy_uint8)AK_CPL_current_to_uint64(cpl, &error, tsep);
-            AK_CPL_CurrentAdvance(cpl);
+        case 1: {
+            npy_uint8 *array_buffer = (npy_uint8*)PyArray_DATA(array);
+            npy_uint8 *end = array_buffer + count;
+            while (array_buffer < end) {
+                *array_buffer++ = (npy_uint8)AK_CPL_current_to_uint64(cpl, &error, tsep);
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
         }
+        default:
+            return -1;
     }
-    else {
-        matched_elsize = false;
-    }
-    NPY_END_THREADS;
-
-    if (!matched_elsize) {
-        PyErr_SetString(PyExc_TypeError, "cannot create array from unsigned integer itemsize");
-        Py_DECREF(array);
-        return NULL;
-    }
-    if (error != 0) {
-        PyErr_SetString(PyExc_TypeError, "error parsing unisigned integer");
-        Py_DECREF(array);
-        return NULL;
-    }
-    PyArray_CLEARFLAGS((PyArrayObject *)array, NPY_ARRAY_WRITEABLE);
-    return array;
+    return error ? 1 : 0;
 }
 
-static inline PyObject*
-AK_CPL_to_array_unicode(AK_CodePointLine* cpl, PyArray_Descr* dtype)
+// Write complex64 or complex128 values. Returns 1 if any field cannot be interpreted, or if the itemsize is not supported; the caller is then expected to have NumPy parse the fields.
+static inline int
+AK_CPL_fill_complex(AK_CodePointLine* cpl, PyArrayObject* array, char decc)
 {
     Py_ssize_t count = cpl->offsets_count;
-    npy_intp dims[] = {count};
+    npy_float64 real, imag;
 
-    Py_ssize_t field_points;
-    // If `capped_points` is True, we have been given a dtype with specific elsize, and we will only load that many code points; if `capper_points` is False, we set the dtype elsize to the max observed code opints via the CPL offset.
-    bool capped_points;
+    AK_CPL_CurrentReset(cpl);
 
-    // mutate the passed dtype as it is new and will be stolen in array construction
-    if (dtype->elsize == 0) {
-        field_points = cpl->offset_max;
-        dtype->elsize = (int)(field_points * UCS4_SIZE);
-        capped_points = false;
+    switch (PyArray_DESCR(array)->elsize) {
+        case 16: {
+            // pairs of real and imaginary components
+            npy_float64 *array_buffer = (npy_float64*)PyArray_DATA(array);
+            npy_float64 *end = array_buffer + count * 2;
+            while (array_buffer < end) {
+                if (AK_CPL_current_to_complex(cpl, decc, &real, &imag)) return 1;
+                *array_buffer++ = real;
+                *array_buffer++ = imag;
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
+        }
+        case 8: {
+            npy_float32 *array_buffer = (npy_float32*)PyArray_DATA(array);
+            npy_float32 *end = array_buffer + count * 2;
+            while (array_buffer < end) {
+                if (AK_CPL_current_to_complex(cpl, decc, &real, &imag)) return 1;
+                *array_buffer++ = (npy_float32)real;
+                *array_buffer++ = (npy_float32)imag;
+                AK_CPL_CurrentAdvance(cpl);
+            }
+            break;
+        }
+        default:
+            return 1;
     }
-    else {
-        // assume that elsize is already given in units of 4
-        // assert(dtype->elsize % UCS4_SIZE == 0);
-        field_points = dtype->elsize / UCS4_SIZE;
-        capped_points = true;
+    return 0;
+}
+
+// Write int64 ticks of the array's unit. Returns 1 if any field cannot be interpreted, or if the unit is not supported; the caller is then expected to have NumPy parse the fields.
+static inline int
+AK_CPL_fill_datetime(AK_CodePointLine* cpl, PyArrayObject* array)
+{
+    PyArray_DatetimeMetaData *meta = AK_datetime_meta(PyArray_DESCR(array));
+    if (meta->num != 1) {
+        return 1;
     }
+    NPY_DATETIMEUNIT unit = meta->base;
+    npy_int64 *array_buffer = (npy_int64*)PyArray_DATA(array);
+    npy_int64 *end = array_buffer + cpl->offsets_count;
+    AK_Datetime dt;
 
-    // NOTE: it is assumed (though not verified in some testing) that we need to get zeroed array here as we might copy to the array with less than the full item size width
-    PyObject *array = PyArray_Zeros(1, dims, dtype, 0); // increfs dtype
-    if (array == NULL) {
-        // expected array to steal dtype reference
-        return NULL;
+    AK_CPL_CurrentReset(cpl);
+    while (array_buffer < end) {
+        if (AK_CPL_current_to_datetime(cpl, &dt)
+                || AK_datetime_to_ticks(&dt, unit, array_buffer)) {
+            return 1;
+        }
+        ++array_buffer;
+        AK_CPL_CurrentAdvance(cpl);
     }
+    return 0;
+}
 
-    Py_UCS4 *array_buffer = (Py_UCS4*)PyArray_DATA((PyArrayObject*)array);
-    Py_UCS4 *end = array_buffer + count * field_points;
+// The array must be zeroed, as we might copy less than the full itemsize. Code points are copied directly when the CPL stores 4-byte units, and otherwise widened into the array.
+static inline int
+AK_CPL_fill_unicode(AK_CodePointLine* cpl, PyArrayObject* array)
+{
+    Py_ssize_t count = cpl->offsets_count;
+    Py_ssize_t field_points = PyArray_DESCR(array)->elsize / UCS4_SIZE;
+    int kind = cpl->kind;
 
-    NPY_BEGIN_THREADS_DEF;
-    NPY_BEGIN_THREADS;
+    Py_UCS4 *array_buffer = (Py_UCS4*)PyArray_DATA(array);
+    Py_UCS4 *end = array_buffer + count * field_points;
+    Py_ssize_t copy_points;
 
     AK_CPL_CurrentReset(cpl);
-    if (capped_points) {
-        Py_ssize_t copy_bytes;
-        while (array_buffer < end) {
-            if (cpl->offsets[cpl->offsets_current_index] >= field_points) {
-                copy_bytes = field_points * UCS4_SIZE;
-            } else {
-                copy_bytes = cpl->offsets[cpl->offsets_current_index] * UCS4_SIZE;
+    while (array_buffer < end) {
+        // If the itemsize was given, some fields might have more points than fit
+        copy_points = AK_CPL_current_len(cpl);
+        if (copy_points > field_points) {
+            copy_points = field_points;
+        }
+        if (kind == PyUnicode_1BYTE_KIND) {
+            Py_UCS1 *p = cpl->buffer_current_ptr;
+            for (Py_ssize_t i = 0; i < copy_points; ++i) {
+                array_buffer[i] = p[i];
             }
-            memcpy(array_buffer,
-                    cpl->buffer_current_ptr,
-                    copy_bytes);
-            array_buffer += field_points;
-            AK_CPL_CurrentAdvance(cpl);
         }
-    }
-    else { // faster if we always know the offset will fit
-        while (array_buffer < end) {
-            memcpy(array_buffer,
-                    cpl->buffer_current_ptr,
-                    cpl->offsets[cpl->offsets_current_index] * UCS4_SIZE);
-            array_buffer += field_points;
-            AK_CPL_CurrentAdvance(cpl);
+        else if (kind == PyUnicode_2BYTE_KIND) {
+            Py_UCS2 *p = (Py_UCS2*)cpl->buffer_current_ptr;
+            for (Py_ssize_t i = 0; i < copy_points; ++i) {
+                array_buffer[i] = p[i];
+            }
         }
+        else {
+            memcpy(array_buffer, cpl->buffer_current_ptr, copy_points * UCS4_SIZE);
+        }
+        array_buffer += field_points;
+        AK_CPL_CurrentAdvance(cpl);
     }
-    NPY_END_THREADS;
-
-    PyArray_CLEARFLAGS((PyArrayObject *)array, NPY_ARRAY_WRITEABLE);
-    return array;
+    return 0;
 }
 
-// Return NULL on error
-static inline PyObject*
-AK_CPL_to_array_bytes(AK_CodePointLine* cpl, PyArray_Descr* dtype)
+// The array must be zeroed, as we might copy less than the full itemsize.
+static inline int
+AK_CPL_fill_bytes(AK_CodePointLine* cpl, PyArrayObject* array)
 {
     Py_ssize_t count = cpl->offsets_count;
-    npy_intp dims[] = {count};
-
-    Py_ssize_t field_points;
-    bool capped_points;
-
-    if (dtype->elsize == 0) {
-        field_points = cpl->offset_max;
-        dtype->elsize = (int)field_points;
-        capped_points = false;
-    }
-    else {
-        field_points = dtype->elsize;
-        capped_points = true;
-    }
-
-    PyObject *array = PyArray_Zeros(1, dims, dtype, 0);
-    if (array == NULL) {
-        // expected array to steal dtype reference
-        return NULL;
-    }
+    Py_ssize_t field_points = PyArray_DESCR(array)->elsize;
+    int kind = cpl->kind;
 
-    char *array_buffer = (char*)PyArray_DATA((PyArrayObject*)array);
+    char *array_buffer = (char*)PyArray_DATA(array);
     char *end = array_buffer + count * field_points;
-    char *field_end;
 
     Py_ssize_t copy_points;
-    Py_UCS4 *p;
-    Py_UCS4 *p_end;
-
-    NPY_BEGIN_THREADS_DEF;
-    NPY_BEGIN_THREADS;
 
     AK_CPL_CurrentReset(cpl);
     while (array_buffer < end) {
-        if (!capped_points || cpl->offsets[cpl->offsets_current_index] < field_points) {
-            // if not capped, or capped and offset is less than field points, use offset
-            copy_points = cpl->offsets[cpl->offsets_current_index];
+        if (AK_CPL_current_len(cpl) < field_points) {
+            copy_points = AK_CPL_current_len(cpl);
         }
         else {
-            // if capped and offset is greater than field points, use field points
+            // if offset is greater than field points, use field points
             copy_points = field_points;
         }
-        // NOTE: not using memcopy as we need to cast to char to fit each point
-        p = cpl->buffer_current_ptr;
-        p_end = p + copy_points;
-        field_end = array_buffer + field_points;
-
-        while (p < p_end) {
-            *array_buffer++ = (char)*p++; // truncate
+        if (kind == PyUnicode_1BYTE_KIND) {
+            memcpy(array_buffer, cpl->buffer_current_ptr, copy_points);
+        }
+        else {
+            // NOTE: not using memcopy as we need to cast to char to fit each point
+            for (Py_ssize_t i = 0; i < copy_points; ++i) {
+                array_buffer[i] = (char)PyUnicode_READ(kind, cpl->buffer_current_ptr, i); // truncate
+            }
         }
-        array_buffer = field_end; // jump to end regardless of how many chars written
+        array_buffer += field_points; // jump to end regardless of how many chars written
         AK_CPL_CurrentAdvance(cpl);
     }
-    NPY_END_THREADS;
+    return 0;
+}
 
-    PyArray_CLEARFLAGS((PyArrayObject *)array, NPY_ARRAY_WRITEABLE);
-    return array;
+// Copy the values of a typed CPL, converted while tokenizing, into an array of the same dtype.
+static inline int
+AK_CPL_fill_typed(AK_CodePointLine* cpl, PyArrayObject* array)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(array);
+    if (dtype->kind != cpl->typed || AK_CPL_typed_kind(dtype) != cpl->typed) return -1;
+    if (cpl->offsets_count) {
+        memcpy(PyArray_DATA(array), cpl->values, dtype->elsize * cpl->offsets_count);
+    }
+    return cpl->typed_error ? 1 : 0;
+}
+
+// Returned by AK_CPL_array_fill if a line of a given integer or bool dtype has an NA value.
+# define AK_CPL_FILL_NA 2
+
+// Fill an array created by AK_CPL_array_new. As an NA value is stored as an empty field, which would be 0 or False, a line of a given (not type parsed) integer or bool dtype with an NA value is not filled. Does not require the GIL.
+static inline int
+AK_CPL_array_fill(AK_CodePointLine* cpl,
+        PyArrayObject* array,
+        char tsep,
+        char decc)
+{
+    char kind = PyArray_DESCR(array)->kind;
+    if (cpl->na_found && cpl->type_parser == NULL
+            && (kind == 'b' || kind == 'i' || kind == 'u')) {
+        return AK_CPL_FILL_NA;
+    }
+    if (cpl->typed) return AK_CPL_fill_typed(cpl, array);
+    switch (kind) {
+        case 'b':
+            return AK_CPL_fill_bool(cpl, array);
+        case 'i':
+            return AK_CPL_fill_int(cpl, array, tsep);
+        case 'u':
+            return AK_CPL_fill_uint(cpl, array, tsep);
+        case 'f':
+            return AK_CPL_fill_float(cpl, array, tsep, decc);
+        case 'U':
+            return AK_CPL_fill_unicode(cpl, array);
+        case 'S':
+            return AK_CPL_fill_bytes(cpl, array);
+        case 'M':
+            return AK_CPL_fill_datetime(cpl, array);
+        case 'c':
+            return AK_CPL_fill_complex(cpl, array, decc);
+    }
+    return -1;
+}
+
+// Given the status returned by AK_CPL_array_fill, set an exception and return -1 if filling failed; otherwise, make the array immutable and return 0.
+static inline int
+AK_CPL_array_check(PyArrayObject* array, int status)
+{
+    if (status == 0) {
+        PyArray_CLEARFLAGS(array, NPY_ARRAY_WRITEABLE);
+        return 0;
+    }
+    if (status == AK_CPL_FILL_NA) {
+        PyErr_Format(PyExc_ValueError, "cannot convert an NA value to %R", PyArray_DESCR(array));
+        return -1;
+    }
+    switch (PyArray_DESCR(array)->kind) {
+        case 'i':
+            PyErr_SetString(PyExc_TypeError, status < 0
+                    ? "cannot create array from integer itemsize"
+                    : "error parsing integer");
+            break;
+        case 'u':
+            PyErr_SetString(PyExc_TypeError, status < 0
+                    ? "cannot create array from unsigned integer itemsize"
+                    : "error parsing unisigned integer");
+            break;
+        case 'f':
+            PyErr_SetString(PyExc_TypeError, status < 0
+                    ? "cannot create array from itemsize"
+                    : "error parsing float");
+            break;
+        default:
+            PyErr_Format(PyExc_NotImplementedError, "No handling for %R", PyArray_DESCR(array));
+    }
+    return -1;
 }
 
 // If we cannot directly convert bytes to values in a pre-loaded array, we can create a bytes or unicode array and then use PyArray_CastToType to use numpy to interpret it as a new a array and handle conversions. Note that we can use bytes for a smaller memory load if we are confident that the values are not unicode. This is a safe assumption for complex. For datetime64, we have to use Unicode to get errors on malformed inputs: using bytes causes a seg fault with these interfaces (the same is not observed with astyping a byte array in Python).
@@ -1959,17 +4200,19 @@ AK_CPL_to_array_via_cast(AK_CodePointLine* cpl,
         Py_DECREF(dtype);
         return NULL;
     }
-    if (type_inter == NPY_STRING) {
-        array_inter = AK_CPL_to_array_bytes(cpl, dtype_inter);
-    }
-    else if (type_inter == NPY_UNICODE) {
-        array_inter = AK_CPL_to_array_unicode(cpl, dtype_inter);
+    if (type_inter == NPY_STRING || type_inter == NPY_UNICODE) {
+        array_inter = AK_CPL_array_new(cpl, dtype_inter);
     }
     // else array_inter is NULL and we exit without an exception set
     if (array_inter == NULL) {
         Py_DECREF(dtype); // dtype_inter ref already stolen
         return NULL;
     }
+    // filling unicode and bytes cannot fail
+    NPY_BEGIN_THREADS_DEF;
+    NPY_BEGIN_THREADS;
+    AK_CPL_array_fill(cpl, (PyArrayObject*)array_inter, '\0', '.');
+    NPY_END_THREADS;
 
     PyObject *array = PyArray_CastToType((PyArrayObject*)array_inter, dtype, 0);
     Py_DECREF(array_inter);
@@ -1980,6 +4223,59 @@ AK_CPL_to_array_via_cast(AK_CodePointLine* cpl,
     return array;
 }
 
+// Given the status returned by AK_CPL_array_fill, return the array if filled. Datetime and complex fields that could not be interpreted natively are given to NumPy to parse (and to raise on malformed fields); other failures set an exception. Steals the array reference. Returns NULL on error.
+static inline PyObject*
+AK_CPL_array_complete(AK_CodePointLine* cpl, PyObject* array, int status)
+{
+    char kind = PyArray_DESCR((PyArrayObject*)array)->kind;
+    if (status == 1 && (kind == 'M' || kind == 'c')) {
+        PyArray_Descr *dtype = PyArray_DESCR((PyArrayObject*)array);
+        Py_INCREF(dtype);
+        Py_DECREF(array);
+        return AK_CPL_to_array_via_cast(cpl, dtype, kind == 'M' ? NPY_UNICODE : NPY_STRING);
+    }
+    if (AK_CPL_array_check((PyArrayObject*)array, status)) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+
+// Convert a CPL to an array of a dtype kind supported by AK_CPL_array_native. Steals the dtype reference. Returns NULL on error.
+static inline PyObject*
+AK_CPL_to_array_native(AK_CodePointLine* cpl,
+        PyArray_Descr* dtype,
+        char tsep,
+        char decc)
+{
+    PyObject *array = AK_CPL_array_new(cpl, dtype);
+    if (array == NULL) {
+        // expected array to steal dtype reference
+        return NULL;
+    }
+    int status;
+
+    NPY_BEGIN_THREADS_DEF;
+    NPY_BEGIN_THREADS;
+    status = AK_CPL_array_fill(cpl, (PyArrayObject*)array, tsep, decc);
+    NPY_END_THREADS;
+
+    return AK_CPL_array_complete(cpl, array, status);
+}
+
+// If passed dtype is NULL, get a fresh dtype from the CPL's type_parser->parsed_line; otherwise, return the passed dtype. Returns NULL on error.
+static inline PyArray_Descr*
+AK_CPL_resolve_dtype(AK_CodePointLine* cpl, PyArray_Descr* dtype)
+{
+    if (dtype) return dtype;
+    // If we have a type_parser on the CPL, we can use that to get the dtype
+    if (cpl->type_parser) {
+        // will return a fresh instance
+        return AK_TP_ToDtype(cpl->type_parser, false, false);
+    }
+    AK_NOT_IMPLEMENTED("dtype not passed to AK_CPL_ToArray, and CodePointLine has no type_parser");
+}
+
 // Generic handler for converting a CPL to an array. The dtype given here must already be a fresh instance as it might be mutated. If passed dtype is NULL, must get dtype from type_parser-> parsed_line Might return NULL if array creation fails; an exception should be set. Will return NULL on error.
 static inline PyObject*
 AK_CPL_ToArray(AK_CodePointLine* cpl,
@@ -1987,61 +4283,366 @@ AK_CPL_ToArray(AK_CodePointLine* cpl,
         char tsep,
         char decc)
 {
-    if (!dtype) {
-        // If we have a type_parser on the CPL, we can use that to get the dtype
-        if (cpl->type_parser) {
-            // will return a fresh instance
-            dtype = AK_TPS_ToDtype(cpl->type_parser->parsed_line);
-            if (dtype == NULL) return NULL;
-        }
-        else {
-            AK_NOT_IMPLEMENTED("dtype not passed to AK_CPL_ToArray, and CodePointLine has no type_parser");
-        }
-    }
-    switch (dtype->kind) {
-        case 'i':
-            return AK_CPL_to_array_int(cpl, dtype, tsep);
-        case 'f':
-            return AK_CPL_to_array_float(cpl, dtype, tsep, decc);
-        case 'U':
-            return AK_CPL_to_array_unicode(cpl, dtype);
-        case 'M':
-            return AK_CPL_to_array_via_cast(cpl, dtype, NPY_UNICODE);
-        case 'b':
-            return AK_CPL_to_array_bool(cpl, dtype);
-        case 'S':
-            return AK_CPL_to_array_bytes(cpl, dtype);
-        case 'u':
-            return AK_CPL_to_array_uint(cpl, dtype, tsep);
-        case 'c': // cannot pass tsep, decc as using NumPy cast
-            return AK_CPL_to_array_via_cast(cpl, dtype, NPY_STRING);
+    dtype = AK_CPL_resolve_dtype(cpl, dtype);
+    if (dtype == NULL) return NULL;
+
+    if (AK_CPL_array_native(dtype->kind)) {
+        return AK_CPL_to_array_native(cpl, dtype, tsep, decc);
     }
     PyErr_Format(PyExc_NotImplementedError, "No handling for %R", dtype);
     // caller will decref the passed dtype on error
     return NULL;
 }
 
+// A distinct field found by AK_CPL_factorize.
+typedef struct AK_CPLUnique {
+    const Py_UCS1 *p;
+    Py_ssize_t len; // in code points
+    npy_uint64 hash;
+} AK_CPLUnique;
+
+// Return the FNV-1a hash of the bytes of `len` code points of `kind`; as all fields in a CPL are of the same kind, fields are equal if their bytes are equal.
+static inline npy_uint64
+AK_hash_points(const Py_UCS1 *p, Py_ssize_t len, int kind)
+{
+    npy_uint64 h = 14695981039346656037ULL;
+    const Py_UCS1 *end = p + len * kind;
+    for (; p < end; ++p) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Assign each field of the CPL, truncated to `max_points`, a code in `codes` by order of first appearance, recording distinct fields in a new `*uniques` array that must be freed by the caller. Uses a hash table with linear probing. Called without the GIL. Returns the number of distinct fields, or -1 on memory failure without setting an exception.
+static Py_ssize_t
+AK_CPL_factorize(AK_CodePointLine* cpl,
+        Py_ssize_t max_points,
+        Py_ssize_t *codes,
+        AK_CPLUnique **uniques)
+{
+    int kind = cpl->kind;
+    Py_ssize_t uniques_count = 0;
+    Py_ssize_t uniques_capacity = 64;
+    Py_ssize_t table_size = 128; // a power of two, kept at least twice uniques_count
+    AK_CPLUnique *u = (AK_CPLUnique*)PyMem_RawMalloc(sizeof(AK_CPLUnique) * uniques_capacity);
+    // positions in `u` plus one, or 0 if empty
+    Py_ssize_t *table = (Py_ssize_t*)PyMem_RawCalloc(table_size, sizeof(Py_ssize_t));
+    if (u == NULL || table == NULL) goto error;
+
+    AK_CPL_CurrentReset(cpl);
+    for (Py_ssize_t i = 0; i < cpl->offsets_count; ++i) {
+        const Py_UCS1 *p = cpl->buffer_current_ptr;
+        Py_ssize_t len = AK_CPL_field_len(cpl, i);
+        if (len > max_points) len = max_points;
+        npy_uint64 h = AK_hash_points(p, len, kind);
+
+        Py_ssize_t mask = table_size - 1;
+        Py_ssize_t pos = (Py_ssize_t)(h & mask);
+        Py_ssize_t code = -1;
+        while (table[pos] != 0) {
+            AK_CPLUnique *v = u + table[pos] - 1;
+            if (v->hash == h && v->len == len && memcmp(v->p, p, len * kind) == 0) {
+                code = table[pos] - 1;
+                break;
+            }
+            pos = (pos + 1) & mask;
+        }
+        if (code < 0) {
+            if (uniques_count == uniques_capacity) {
+                uniques_capacity *= 2;
+                AK_CPLUnique *u_new = (AK_CPLUnique*)PyMem_RawRealloc(u,
+                        sizeof(AK_CPLUnique) * uniques_capacity);
+                if (u_new == NULL) goto error;
+                u = u_new;
+            }
+            code = uniques_count++;
+            u[code] = (AK_CPLUnique){p, len, h};
+            table[pos] = uniques_count;
+
+            if (uniques_count * 2 > table_size) {
+                // rehash into a table of twice the size
+                PyMem_RawFree(table);
+                table_size *= 2;
+                table = (Py_ssize_t*)PyMem_RawCalloc(table_size, sizeof(Py_ssize_t));
+                if (table == NULL) goto error;
+                mask = table_size - 1;
+                for (Py_ssize_t j = 0; j < uniques_count; ++j) {
+                    pos = (Py_ssize_t)(u[j].hash & mask);
+                    while (table[pos] != 0) pos = (pos + 1) & mask;
+                    table[pos] = j + 1;
+                }
+            }
+        }
+        codes[i] = code;
+        AK_CPL_CurrentAdvance(cpl);
+    }
+    PyMem_RawFree(table);
+    *uniques = u;
+    return uniques_count;
+error:
+    PyMem_RawFree(u);
+    PyMem_RawFree(table);
+    return -1;
+}
+
+// Convert a CPL of strings to a tuple of an integer array of codes, of the smallest signed integer dtype that fits, and a unicode array of distinct values in order of first appearance, such that `uniques[codes]` is equal to the array returned by AK_CPL_ToArray. The dtype must be a fresh unicode instance; steals the dtype reference. Returns NULL on error.
+static PyObject*
+AK_CPL_ToCategorical(AK_CodePointLine* cpl, PyArray_Descr* dtype)
+{
+    if (dtype->elsize == 0) {
+        AK_CPL_size_dtype(cpl, dtype);
+    }
+    Py_ssize_t max_points = dtype->elsize / UCS4_SIZE;
+    Py_ssize_t count = cpl->offsets_count;
+    AK_CPLUnique *u = NULL;
+    Py_ssize_t uniques_count;
+
+    Py_ssize_t *codes = (Py_ssize_t*)PyMem_RawMalloc(sizeof(Py_ssize_t) * (count > 0 ? count : 1));
+    if (codes == NULL) {
+        Py_DECREF(dtype);
+        return PyErr_NoMemory();
+    }
+    Py_BEGIN_ALLOW_THREADS
+    uniques_count = AK_CPL_factorize(cpl, max_points, codes, &u);
+    Py_END_ALLOW_THREADS
+    if (uniques_count < 0) {
+        PyMem_RawFree(codes);
+        Py_DECREF(dtype);
+        return PyErr_NoMemory();
+    }
+
+    int codes_type = uniques_count <= NPY_MAX_INT8 + 1 ? NPY_INT8
+            : uniques_count <= NPY_MAX_INT16 + 1 ? NPY_INT16
+            : uniques_count <= (Py_ssize_t)NPY_MAX_INT32 + 1 ? NPY_INT32
+            : NPY_INT64;
+    npy_intp dims[] = {count};
+    PyArrayObject *codes_array = (PyArrayObject*)PyArray_EMPTY(1, dims, codes_type, 0);
+    dims[0] = uniques_count;
+    PyArrayObject *uniques = (PyArrayObject*)PyArray_Zeros(1, dims, dtype, 0); // steals dtype ref
+    if (codes_array == NULL || uniques == NULL) {
+        Py_XDECREF(codes_array);
+        Py_XDECREF(uniques);
+        PyMem_RawFree(codes);
+        PyMem_RawFree(u);
+        return NULL;
+    }
+    void *data = PyArray_DATA(codes_array);
+    int kind = cpl->kind;
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        switch (codes_type) {
+            case NPY_INT8: ((npy_int8*)data)[i] = (npy_int8)codes[i]; break;
+            case NPY_INT16: ((npy_int16*)data)[i] = (npy_int16)codes[i]; break;
+            case NPY_INT32: ((npy_int32*)data)[i] = (npy_int32)codes[i]; break;
+            default: ((npy_int64*)data)[i] = (npy_int64)codes[i];
+        }
+    }
+    Py_UCS4 *unique_buffer = (Py_UCS4*)PyArray_DATA(uniques);
+    for (Py_ssize_t j = 0; j < uniques_count; ++j) {
+        for (Py_ssize_t i = 0; i < u[j].len; ++i) {
+            unique_buffer[i] = PyUnicode_READ(kind, u[j].p, i);
+        }
+        unique_buffer += max_points;
+    }
+    Py_END_ALLOW_THREADS
+    PyMem_RawFree(codes);
+    PyMem_RawFree(u);
+
+    PyObject *tuple = PyTuple_Pack(2, codes_array, uniques);
+    Py_DECREF(codes_array);
+    Py_DECREF(uniques);
+    return tuple; // might be NULL
+}
+
 //------------------------------------------------------------------------------
-// utility function used by CPG and DR
+// AK_LineSelect: line_select given as a callable, or as a boolean or integer array resolved before parsing into a flag per line position
+
+typedef struct AK_LineSelect {
+    PyObject *callable; // NULL unless given a callable
+    npy_bool *keep;     // given an array, positions at or beyond count are not kept; given a callable, results cached by AK_LS_field_keep
+    Py_ssize_t count;
+    Py_ssize_t capacity; // of keep, when caching results of a callable
+    npy_int64 *positions; // given sparse integer positions, sorted positions to keep, used instead of keep
+    Py_ssize_t positions_count;
+} AK_LineSelect;
+
+// Integer positions are resolved into flags if the flags are no larger than this, or than AK_LS_FLAGS_PER_POSITION bytes for each position given; otherwise, sorted positions are searched.
+# define AK_LS_FLAGS_MIN 65536
+# define AK_LS_FLAGS_PER_POSITION 64
+
+static inline bool
+AK_LS_inactive(const AK_LineSelect *ls)
+{
+    return ls->callable == NULL && ls->keep == NULL && ls->positions == NULL;
+}
+
+// Return true if `position` is among the sorted positions of `ls`.
+static inline bool
+AK_LS_positions_keep(const AK_LineSelect *ls, Py_ssize_t position)
+{
+    Py_ssize_t low = 0;
+    Py_ssize_t high = ls->positions_count;
+    while (low < high) {
+        Py_ssize_t mid = low + (high - low) / 2;
+        if (ls->positions[mid] < position) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low < ls->positions_count && ls->positions[low] == position;
+}
+
+static int
+AK_int64_compare(const void *a, const void *b)
+{
+    npy_int64 x = *(const npy_int64*)a;
+    npy_int64 y = *(const npy_int64*)b;
+    return (x > y) - (x < y);
+}
+
+// Release resources held by an AK_LineSelect, leaving it inactive.
+static void
+AK_LS_Clear(AK_LineSelect *ls)
+{
+    Py_CLEAR(ls->callable);
+    PyMem_RawFree(ls->keep);
+    ls->keep = NULL;
+    ls->count = 0;
+    ls->capacity = 0;
+    PyMem_RawFree(ls->positions);
+    ls->positions = NULL;
+    ls->positions_count = 0;
+}
+
+// Set an AK_LineSelect from a line_select argument: None (or NULL), a callable, a boolean array of flags by position, or an integer array of positions to keep. Returns 0 on success, -1 on error.
+static int
+AK_LS_Set(AK_LineSelect *ls, PyObject *line_select)
+{
+    ls->callable = NULL;
+    ls->keep = NULL;
+    ls->count = 0;
+    ls->capacity = 0;
+    ls->positions = NULL;
+    ls->positions_count = 0;
+    if ((line_select == NULL) || (line_select == Py_None)) {
+        return 0;
+    }
+    if (PyCallable_Check(line_select)) {
+        Py_INCREF(line_select);
+        ls->callable = line_select;
+        return 0;
+    }
+    PyArrayObject *a = (PyArrayObject*)PyArray_FROM_O(line_select);
+    if (a == NULL) return -1;
+
+    char kind = PyArray_DESCR(a)->kind;
+    if (PyArray_NDIM(a) != 1 || (PyArray_SIZE(a) > 0
+            && kind != 'b' && kind != 'i' && kind != 'u')) {
+        Py_DECREF(a);
+        PyErr_SetString(PyExc_TypeError,
+                "line_select must be a callable, a one-dimensional boolean or integer array, or None");
+        return -1;
+    }
+    // cast to contiguous flags or positions
+    PyArrayObject *values = (PyArrayObject*)PyArray_FROM_OTF((PyObject*)a,
+            kind == 'b' ? NPY_BOOL : NPY_INT64,
+            NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+    Py_DECREF(a);
+    if (values == NULL) return -1;
+    Py_ssize_t size = PyArray_SIZE(values);
+
+    if (kind == 'b') {
+        ls->count = size;
+        ls->keep = (npy_bool*)PyMem_RawMalloc(size > 0 ? size : 1);
+        if (ls->keep == NULL) goto error_memory;
+        memcpy(ls->keep, PyArray_DATA(values), size);
+    }
+    else {
+        npy_int64 *positions = (npy_int64*)PyArray_DATA(values);
+        npy_int64 max = -1;
+        for (Py_ssize_t i = 0; i < size; ++i) {
+            if (positions[i] < 0) {
+                Py_DECREF(values);
+                PyErr_SetString(PyExc_ValueError, "line_select positions must be non-negative");
+                return -1;
+            }
+            if (positions[i] > max) max = positions[i];
+        }
+        if (max >= AK_LS_FLAGS_MIN && max / AK_LS_FLAGS_PER_POSITION >= size) {
+            // sparse positions, as with a large position, are not resolved into flags
+            ls->positions = (npy_int64*)PyMem_RawMalloc(sizeof(npy_int64) * size);
+            if (ls->positions == NULL) goto error_memory;
+            memcpy(ls->positions, positions, sizeof(npy_int64) * size);
+            qsort(ls->positions, size, sizeof(npy_int64), AK_int64_compare);
+            ls->positions_count = size;
+            Py_DECREF(values);
+            return 0;
+        }
+        ls->count = (Py_ssize_t)(max + 1);
+        ls->keep = (npy_bool*)PyMem_RawCalloc(ls->count > 0 ? ls->count : 1, 1);
+        if (ls->keep == NULL) goto error_memory;
+        for (Py_ssize_t i = 0; i < size; ++i) {
+            ls->keep[positions[i]] = 1;
+        }
+    }
+    Py_DECREF(values);
+    return 0;
+error_memory:
+    Py_DECREF(values);
+    PyErr_NoMemory();
+    return -1;
+}
+
+// Set an AK_LineSelect from a categorical argument: None or False for no lines, True for all lines, or any line_select argument for the lines to be selected. Sets `*selected` to NULL if no lines are selected, else to `ls`; as an inactive AK_LineSelect keeps all positions, True leaves `ls` inactive. Returns 0 on success, -1 on error.
+static int
+AK_LS_SetCategorical(AK_LineSelect *ls,
+        PyObject *categorical,
+        AK_LineSelect **selected)
+{
+    *selected = NULL;
+    if (categorical == NULL || categorical == Py_None || categorical == Py_False) {
+        return AK_LS_Set(ls, NULL);
+    }
+    if (categorical == Py_True) {
+        *selected = ls;
+        return AK_LS_Set(ls, NULL);
+    }
+    if (AK_LS_Set(ls, categorical)) return -1;
+    *selected = ls;
+    return 0;
+}
+
+// Return 1 if the line at `lookup_number` is to be kept, 0 if not, or -1 on error. Lines are always kept if line_select is NULL or does not target this axis.
 static inline int
 AK_line_select_keep(
-        PyObject *line_select,
+        const AK_LineSelect *line_select,
         bool axis_target,
         Py_ssize_t lookup_number)
 {
-    if (axis_target && (line_select != NULL)) {
+    if (!axis_target || line_select == NULL) return 1;
+    if (line_select->positions != NULL) {
+        return AK_LS_positions_keep(line_select, lookup_number);
+    }
+    if (line_select->callable == NULL) {
+        return line_select->keep == NULL || (lookup_number < line_select->count
+                && line_select->keep[lookup_number]);
+    }
+    else {
         PyObject* number = PyLong_FromSsize_t(lookup_number);
         if (number == NULL) return -1;
 
         PyObject* keep = PyObject_CallFunctionObjArgs(
-                line_select,
+                line_select->callable,
                 number,
                 NULL
                 );
         Py_DECREF(number);
         if (keep == NULL) {
             PyErr_Format(PyExc_RuntimeError,
-                    "line_select callable failed for input: %d",
+                    "line_select callable failed for input: %zd",
                     lookup_number
                     );
             return -1;
@@ -2054,7 +4655,303 @@ AK_line_select_keep(
         }
         return t; // 0 or 1
     }
-    return 1;
+}
+
+// Return 1 if the field at `position` is to be kept, 0 if not, or -1 on error. As this is called while tokenizing, results of a callable are cached such that it is called once per position; only requires the GIL when given a callable.
+static inline int
+AK_LS_field_keep(AK_LineSelect *ls, Py_ssize_t position)
+{
+    if (position < ls->count) return ls->keep[position];
+    if (ls->positions != NULL) return AK_LS_positions_keep(ls, position);
+    if (ls->callable == NULL) return ls->keep == NULL;
+
+    if (position >= ls->capacity) {
+        Py_ssize_t capacity = ls->capacity > 0 ? ls->capacity : 64;
+        while (position >= capacity) capacity *= 2;
+        npy_bool *keep = (npy_bool*)PyMem_RawRealloc(ls->keep, capacity);
+        if (keep == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        ls->keep = keep;
+        ls->capacity = capacity;
+    }
+    for (; ls->count <= position; ++ls->count) {
+        int t = AK_line_select_keep(ls, true, ls->count);
+        if (t < 0) return -1;
+        ls->keep[ls->count] = (npy_bool)t;
+    }
+    return ls->keep[position];
+}
+
+//------------------------------------------------------------------------------
+// AK_RowFilter: tests on the raw fields of a record, evaluated in C while tokenizing, such that records that fail are dropped before their fields reach the CPG
+
+typedef enum AK_RowTestKind {
+    RT_IN,    // the field equals one of `values`
+    RT_RANGE, // the field, parsed as a float, is within `low` and `high`, inclusive
+} AK_RowTestKind;
+
+typedef struct AK_RowTestValue {
+    Py_ssize_t len;
+    Py_UCS4 *points;
+} AK_RowTestValue;
+
+typedef struct AK_RowTest {
+    Py_ssize_t column;
+    AK_RowTestKind kind;
+    AK_RowTestValue *values; // sorted by AK_RTV_compare
+    Py_ssize_t values_count;
+    npy_float64 low;
+    npy_float64 high;
+} AK_RowTest;
+
+typedef struct AK_RowFilter {
+    AK_RowTest *tests; // all must pass
+    Py_ssize_t count;
+    char tsep;
+    char decc;
+} AK_RowFilter;
+
+// Order values by length, then by code points.
+static int
+AK_RTV_compare(const void *a, const void *b)
+{
+    const AK_RowTestValue *va = (const AK_RowTestValue*)a;
+    const AK_RowTestValue *vb = (const AK_RowTestValue*)b;
+    if (va->len != vb->len) return va->len < vb->len ? -1 : 1;
+    for (Py_ssize_t i = 0; i < va->len; ++i) {
+        if (va->points[i] != vb->points[i]) return va->points[i] < vb->points[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// Compare a field of `len` code points of `kind` to `v`, in the order of AK_RTV_compare.
+static inline int
+AK_RTV_compare_field(const AK_RowTestValue *v, int kind, const void *field, Py_ssize_t len)
+{
+    if (len != v->len) return len < v->len ? -1 : 1;
+    for (Py_ssize_t i = 0; i < len; ++i) {
+        Py_UCS4 c = PyUnicode_READ(kind, field, i);
+        if (c != v->points[i]) return c < v->points[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// Fields of a kind wider than PyUnicode_1BYTE_KIND of up to this many code points are narrowed for a range test without allocating.
+# define AK_RT_POINTS_BUFFER 128
+
+// Return true if the field of `len` code points of `kind` passes the test. Does not require the GIL.
+static inline bool
+AK_RT_keep(const AK_RowTest *test,
+        int kind,
+        const void *field,
+        Py_ssize_t len,
+        char tsep,
+        char decc)
+{
+    if (test->kind == RT_RANGE) {
+        if (len == 0) return false;
+        int error = 0;
+        Py_UCS1 *p = (Py_UCS1*)field;
+        Py_UCS1 buffer[AK_RT_POINTS_BUFFER];
+        Py_UCS1 *points = NULL;
+        if (kind != PyUnicode_1BYTE_KIND) {
+            // a wider kind might be due to another field of the record; parse if all points are ASCII
+            if (len > AK_RT_POINTS_BUFFER) {
+                points = (Py_UCS1*)PyMem_RawMalloc(len);
+                if (points == NULL) return false; // cannot set an exception here
+            }
+            p = points != NULL ? points : buffer;
+            for (Py_ssize_t i = 0; i < len; ++i) {
+                Py_UCS4 c = PyUnicode_READ(kind, field, i);
+                if (c >= 0x80) {
+                    PyMem_RawFree(points);
+                    return false;
+                }
+                p[i] = (Py_UCS1)c;
+            }
+        }
+        npy_float64 v = AK_UCS1_to_float64(p, p + len, &error, tsep, decc);
+        PyMem_RawFree(points);
+        return !error && test->low <= v && v <= test->high;
+    }
+    // binary search of sorted values
+    Py_ssize_t lo = 0;
+    Py_ssize_t hi = test->values_count;
+    while (lo < hi) {
+        Py_ssize_t mid = lo + (hi - lo) / 2;
+        int c = AK_RTV_compare_field(test->values + mid, kind, field, len);
+        if (c == 0) return true;
+        if (c < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    return false;
+}
+
+// Return true if a record, given as a CPL with a field per offset, passes all tests; records without a tested column fail. Does not require the GIL.
+static bool
+AK_RF_keep(const AK_RowFilter *rf, const AK_CodePointLine *cpl)
+{
+    int kind = cpl->kind;
+    for (Py_ssize_t i = 0; i < rf->count; ++i) {
+        const AK_RowTest *test = rf->tests + i;
+        if (test->column >= cpl->offsets_count) return false;
+        if (!AK_RT_keep(test,
+                kind,
+                AK_CPL_field_ptr(cpl, test->column),
+                AK_CPL_field_len(cpl, test->column),
+                rf->tsep,
+                rf->decc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void
+AK_RF_Free(AK_RowFilter *rf)
+{
+    for (Py_ssize_t i = 0; i < rf->count; ++i) {
+        AK_RowTest *test = rf->tests + i;
+        for (Py_ssize_t j = 0; j < test->values_count; ++j) {
+            PyMem_Free(test->values[j].points);
+        }
+        PyMem_Free(test->values);
+    }
+    PyMem_Free(rf->tests);
+    PyMem_Free(rf);
+}
+
+// Append a value for an RT_IN test from a str. Returns 0 on success, -1 on error.
+static int
+AK_RT_append_value(AK_RowTest *test, PyObject *value)
+{
+    if (!PyUnicode_Check(value)) {
+        PyErr_Format(PyExc_TypeError,
+                "row_filter values must be str, not %.200s",
+                Py_TYPE(value)->tp_name);
+        return -1;
+    }
+    AK_RowTestValue *v = test->values + test->values_count;
+    v->points = PyUnicode_AsUCS4Copy(value);
+    if (v->points == NULL) return -1;
+    v->len = PyUnicode_GET_LENGTH(value);
+    ++test->values_count;
+    return 0;
+}
+
+// Set an AK_RowTest from a (column, test) tuple, where test is a str, a set of str, or a (low, high) tuple of numbers or None. Returns 0 on success, -1 on error.
+static int
+AK_RT_set(AK_RowTest *test, PyObject *spec)
+{
+    if (!PyTuple_Check(spec) || PyTuple_GET_SIZE(spec) != 2) {
+        PyErr_SetString(PyExc_TypeError,
+                "row_filter must be a (column, test) tuple, a list of such tuples, or None");
+        return -1;
+    }
+    test->column = PyNumber_AsSsize_t(PyTuple_GET_ITEM(spec, 0), PyExc_OverflowError);
+    if (test->column == -1 && PyErr_Occurred()) return -1;
+    if (test->column < 0) {
+        PyErr_SetString(PyExc_ValueError, "row_filter columns must be non-negative");
+        return -1;
+    }
+    PyObject *t = PyTuple_GET_ITEM(spec, 1);
+    if (PyUnicode_Check(t)) {
+        test->kind = RT_IN;
+        test->values = (AK_RowTestValue*)PyMem_Malloc(sizeof(AK_RowTestValue));
+        if (test->values == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        return AK_RT_append_value(test, t);
+    }
+    if (PyAnySet_Check(t)) {
+        test->kind = RT_IN;
+        Py_ssize_t size = PySet_GET_SIZE(t);
+        test->values = (AK_RowTestValue*)PyMem_Malloc(sizeof(AK_RowTestValue) * (size > 0 ? size : 1));
+        if (test->values == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        PyObject *iter = PyObject_GetIter(t);
+        if (iter == NULL) return -1;
+        PyObject *value;
+        while ((value = PyIter_Next(iter))) {
+            int status = AK_RT_append_value(test, value);
+            Py_DECREF(value);
+            if (status) {
+                Py_DECREF(iter);
+                return -1;
+            }
+        }
+        Py_DECREF(iter);
+        if (PyErr_Occurred()) return -1;
+        qsort(test->values, test->values_count, sizeof(AK_RowTestValue), AK_RTV_compare);
+        return 0;
+    }
+    if (PyTuple_Check(t) && PyTuple_GET_SIZE(t) == 2) {
+        test->kind = RT_RANGE;
+        npy_float64 bounds[2] = {-NPY_INFINITY, NPY_INFINITY};
+        for (Py_ssize_t i = 0; i < 2; ++i) {
+            PyObject *bound = PyTuple_GET_ITEM(t, i);
+            if (bound == Py_None) continue;
+            if (!PyNumber_Check(bound) || PyUnicode_Check(bound)) {
+                PyErr_SetString(PyExc_TypeError,
+                        "row_filter range bounds must be numbers or None");
+                return -1;
+            }
+            bounds[i] = PyFloat_AsDouble(bound);
+            if (bounds[i] == -1.0 && PyErr_Occurred()) return -1;
+        }
+        test->low = bounds[0];
+        test->high = bounds[1];
+        return 0;
+    }
+    PyErr_SetString(PyExc_TypeError,
+            "row_filter tests must be a str, a set of str, or a (low, high) tuple");
+    return -1;
+}
+
+// Return a new AK_RowFilter from a (column, test) tuple or a list of such tuples; returns NULL with no exception set if `row_filter` is NULL or None, or NULL with an exception set on error.
+static AK_RowFilter*
+AK_RF_New(PyObject *row_filter, Py_UCS4 tsep, Py_UCS4 decc)
+{
+    if (row_filter == NULL || row_filter == Py_None) return NULL;
+
+    Py_ssize_t count;
+    if (PyTuple_Check(row_filter)) {
+        count = 1;
+    }
+    else if (PyList_Check(row_filter)) {
+        count = PyList_GET_SIZE(row_filter);
+    }
+    else {
+        PyErr_SetString(PyExc_TypeError,
+                "row_filter must be a (column, test) tuple, a list of such tuples, or None");
+        return NULL;
+    }
+    AK_RowFilter *rf = (AK_RowFilter*)PyMem_Malloc(sizeof(AK_RowFilter));
+    if (rf == NULL) return (AK_RowFilter*)PyErr_NoMemory();
+    rf->tests = (AK_RowTest*)PyMem_Calloc(count > 0 ? count : 1, sizeof(AK_RowTest));
+    if (rf->tests == NULL) {
+        PyMem_Free(rf);
+        return (AK_RowFilter*)PyErr_NoMemory();
+    }
+    rf->count = count;
+    // as the characters are given to AK_UCS1_to_float64, only ASCII characters are used
+    rf->tsep = tsep < 0x80 ? (char)tsep : '\0';
+    rf->decc = decc < 0x80 ? (char)decc : '.';
+
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        PyObject *spec = PyTuple_Check(row_filter)
+                ? row_filter : PyList_GET_ITEM(row_filter, i);
+        if (AK_RT_set(rf->tests + i, spec)) {
+            AK_RF_Free(rf);
+            return NULL;
+        }
+    }
+    return rf;
 }
 
 //------------------------------------------------------------------------------
@@ -2063,53 +4960,219 @@ AK_line_select_keep(
 typedef struct AK_CodePointGrid {
     Py_ssize_t lines_count;    // accumulated number of lines
     Py_ssize_t lines_capacity; // max number of lines
+    Py_ssize_t lines_allocated; // number of CPLs owned, including those retained for reuse after lines_count
     AK_CodePointLine **lines;  // array of pointers
-    PyObject *dtypes;          // a callable that returns None or a dtype initializer
+    Py_ssize_t line_offset;    // added to a line's position when calling dtypes
+    PyObject *dtypes;          // NULL or a callable that returns None or a dtype initializer
+    PyArray_Descr **dtypes_array; // NULL, or dtypes by line position, with NULL for lines to be type parsed
+    Py_ssize_t dtypes_count;   // positions at or beyond this are type parsed
+    bool narrow_int;           // type parsed int lines use the smallest dtype that fits
+    bool narrow_float;         // type parsed float lines use float32 where exact
+    const AK_NAValues *na_values; // NULL, or borrowed and given to each CPL
+    bool discard;              // CPLs only type parse, as for AK_CPG_ToDtypeList
+    Py_ssize_t fields_capacity; // if greater than zero, the capacity for fields of new CPLs, as set by AK_CPG_presize
     Py_UCS4 tsep;
     Py_UCS4 decc;
 } AK_CodePointGrid;
 
-// Create a new Code Point Grid; returns NULL on error. Missing `dtypes` has been normalized as NULL.
-AK_CodePointGrid*
-AK_CPG_New(PyObject *dtypes, Py_UCS4 tsep, Py_UCS4 decc)
+// Set one dtype in the CPG's dtypes_array from a dtype initializer, or leave it NULL if `dtype_specifier` is None. Returns 0 on success, -1 on error.
+static int
+AK_CPG_set_dtype(AK_CodePointGrid* cpg, Py_ssize_t line, PyObject* dtype_specifier)
+{
+    if (dtype_specifier == Py_None) return 0;
+    PyArray_Descr *dtype = NULL;
+    if (!PyArray_DescrConverter(dtype_specifier, &dtype)) return -1;
+    Py_XSETREF(cpg->dtypes_array[line], dtype);
+    return 0;
+}
+
+// Set the CPG's dtypes from a dtypes argument: None (or NULL), a callable, a sequence of dtype initializers (or None) by line position, or a dict of line positions to dtype initializers (or None). A sequence or dict is resolved here into dtypes_array, such that no Python calls are needed per line. Returns 0 on success, -1 on error.
+static int
+AK_CPG_set_dtypes(AK_CodePointGrid* cpg, PyObject* dtypes)
 {
-    // normalize dtypes to NULL or callable
     if ((dtypes == NULL) || (dtypes == Py_None)) {
-        dtypes = NULL;
+        return 0;
     }
-    else if (!PyCallable_Check(dtypes)) {
-        PyErr_SetString(PyExc_TypeError, "dtypes must be a callable or None");
-        return NULL;
+    if (PyCallable_Check(dtypes)) {
+        Py_INCREF(dtypes);
+        cpg->dtypes = dtypes;
+        return 0;
+    }
+    if (PyDict_Check(dtypes)) {
+        PyObject *key;
+        PyObject *value;
+        Py_ssize_t pos = 0;
+        Py_ssize_t max = -1;
+        while (PyDict_Next(dtypes, &pos, &key, &value)) {
+            Py_ssize_t line = PyLong_Check(key) ? PyLong_AsSsize_t(key) : -1;
+            if (line < 0) {
+                if (!PyErr_Occurred()) {
+                    PyErr_SetString(PyExc_ValueError,
+                            "dtypes dict keys must be non-negative integers");
+                }
+                return -1;
+            }
+            if (line > max) max = line;
+        }
+        cpg->dtypes_count = max + 1;
+        cpg->dtypes_array = (PyArray_Descr**)PyMem_RawCalloc(
+                cpg->dtypes_count > 0 ? cpg->dtypes_count : 1,
+                sizeof(PyArray_Descr*));
+        if (cpg->dtypes_array == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        pos = 0;
+        while (PyDict_Next(dtypes, &pos, &key, &value)) {
+            if (AK_CPG_set_dtype(cpg, PyLong_AsSsize_t(key), value)) return -1;
+        }
+        return 0;
+    }
+    if (PySequence_Check(dtypes) && !PyUnicode_Check(dtypes) && !PyBytes_Check(dtypes)) {
+        PyObject *seq = PySequence_Fast(dtypes, "dtypes must be a sequence");
+        if (seq == NULL) return -1;
+        Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+        cpg->dtypes_count = count;
+        cpg->dtypes_array = (PyArray_Descr**)PyMem_RawCalloc(
+                count > 0 ? count : 1,
+                sizeof(PyArray_Descr*));
+        if (cpg->dtypes_array == NULL) {
+            Py_DECREF(seq);
+            PyErr_NoMemory();
+            return -1;
+        }
+        PyObject **items = PySequence_Fast_ITEMS(seq);
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            if (AK_CPG_set_dtype(cpg, i, items[i])) {
+                Py_DECREF(seq);
+                return -1;
+            }
+        }
+        Py_DECREF(seq);
+        return 0;
+    }
+    PyErr_SetString(PyExc_TypeError, "dtypes must be a callable, a sequence, a dict, or None");
+    return -1;
+}
+
+// Give `cpg` the dtypes_array and line_offset of `source`, such that lines of resolved dtypes are not type parsed. Returns 0 on success, -1 on error.
+static int
+AK_CPG_copy_dtypes(AK_CodePointGrid* cpg, AK_CodePointGrid* source)
+{
+    cpg->line_offset = source->line_offset;
+    if (source->dtypes_array == NULL) return 0;
+    cpg->dtypes_array = (PyArray_Descr**)PyMem_RawCalloc(
+            source->dtypes_count > 0 ? source->dtypes_count : 1,
+            sizeof(PyArray_Descr*));
+    if (cpg->dtypes_array == NULL) {
+        PyErr_NoMemory();
+        return -1;
     }
+    cpg->dtypes_count = source->dtypes_count;
+    for (Py_ssize_t i = 0; i < cpg->dtypes_count; ++i) {
+        Py_XINCREF(source->dtypes_array[i]);
+        cpg->dtypes_array[i] = source->dtypes_array[i];
+    }
+    return 0;
+}
+
+// Returns true if the line at `line`, a position among all lines, will be type parsed given an array of dtypes.
+static inline bool
+AK_CPG_dtypes_array_parse(AK_CodePointGrid* cpg, Py_ssize_t line)
+{
+    return line >= cpg->dtypes_count || cpg->dtypes_array[line] == NULL;
+}
 
-    AK_CodePointGrid *cpg = (AK_CodePointGrid*)PyMem_Malloc(sizeof(AK_CodePointGrid));
+void AK_CPG_Free(AK_CodePointGrid* cpg);
+
+// Create a new Code Point Grid; returns NULL on error.
+AK_CodePointGrid*
+AK_CPG_New(PyObject *dtypes, Py_UCS4 tsep, Py_UCS4 decc)
+{
+    AK_CodePointGrid *cpg = (AK_CodePointGrid*)PyMem_RawMalloc(sizeof(AK_CodePointGrid));
     if (cpg == NULL) return (AK_CodePointGrid*)PyErr_NoMemory();
 
+    cpg->dtypes = NULL;
+    cpg->dtypes_array = NULL;
+    cpg->dtypes_count = 0;
+    cpg->narrow_int = false;
+    cpg->narrow_float = false;
+    cpg->na_values = NULL;
+    cpg->discard = false;
+    cpg->fields_capacity = 0;
     cpg->tsep = tsep;
     cpg->decc = decc;
     cpg->lines_count = 0;
+    cpg->lines_allocated = 0;
+    cpg->line_offset = 0;
     cpg->lines_capacity = 1024;
-    cpg->lines = (AK_CodePointLine**)PyMem_Malloc(
+    // NOTE: lines might be grown without the GIL when tokenizing on threads
+    cpg->lines = (AK_CodePointLine**)PyMem_RawMalloc(
             sizeof(AK_CodePointLine*) * cpg->lines_capacity);
-    if (cpg->lines == NULL) return (AK_CodePointGrid*)PyErr_NoMemory();
-
-    cpg->dtypes = dtypes;
+    if (cpg->lines == NULL) {
+        PyMem_RawFree(cpg);
+        return (AK_CodePointGrid*)PyErr_NoMemory();
+    }
+    if (AK_CPG_set_dtypes(cpg, dtypes)) {
+        AK_CPG_Free(cpg);
+        return NULL;
+    }
     return cpg;
 }
 
+// Lines might be NULL if they have been transferred to another CPG. Requires the GIL if the CPG has dtypes.
 void
 AK_CPG_Free(AK_CodePointGrid* cpg)
 {
-    for (Py_ssize_t i=0; i < cpg->lines_count; ++i) {
-        AK_CPL_Free(cpg->lines[i]);
+    for (Py_ssize_t i=0; i < cpg->lines_allocated; ++i) {
+        if (cpg->lines[i]) {
+            AK_CPL_Free(cpg->lines[i]);
+        }
+    }
+    if (cpg->dtypes_array) {
+        for (Py_ssize_t i = 0; i < cpg->dtypes_count; ++i) {
+            Py_XDECREF(cpg->dtypes_array[i]);
+        }
+        PyMem_RawFree(cpg->dtypes_array);
+    }
+    Py_XDECREF(cpg->dtypes);
+    PyMem_RawFree(cpg->lines);
+    PyMem_RawFree(cpg);
+}
+
+// Remove all lines such that the CPG can be loaded again; CPLs are retained and reused by AK_CPG_resize. `line_offset` is the position of the next line loaded within all lines, as given to dtypes.
+static void
+AK_CPG_Clear(AK_CodePointGrid* cpg, Py_ssize_t line_offset)
+{
+    cpg->lines_count = 0;
+    cpg->line_offset = line_offset;
+}
+
+// Size a new CPG for `records` records, such that lines are not grown while tokenizing: with axis 0, each record is a line; with axis 1, each line has a field per record. Returns 0 on success, -1 on error.
+static int
+AK_CPG_presize(AK_CodePointGrid* cpg, int axis, Py_ssize_t records)
+{
+    if (records <= 0) return 0;
+    if (axis == 1) {
+        cpg->fields_capacity = records;
+    }
+    else if (records > cpg->lines_capacity) {
+        AK_CodePointLine **lines = PyMem_RawRealloc(cpg->lines,
+                sizeof(AK_CodePointLine*) * records);
+        if (lines == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        cpg->lines = lines;
+        cpg->lines_capacity = records;
     }
-    PyMem_Free(cpg->lines);
-    PyMem_Free(cpg);
+    return 0;
 }
+
 //------------------------------------------------------------------------------
 // CodePointGrid: Mutation
 
-// Determine if a new CPL needs to be created and add it if needed. Return 0 on succes, -1 on failure.
+// Determine if a new CPL needs to be created and add it if needed. Return 0 on succes, -1 on failure. An exception is only set if the dtypes callable fails; memory failures do not set an exception, as without a dtypes callable (including with dtypes resolved to an array) this is called without the GIL.
 static inline int
 AK_CPG_resize(AK_CodePointGrid* cpg, Py_ssize_t line)
 {
@@ -2117,21 +5180,34 @@ AK_CPG_resize(AK_CodePointGrid* cpg, Py_ssize_t line)
     if (line < lines_count) return 0; // most common scenario
 
     if (AK_UNLIKELY(line >= cpg->lines_capacity)) {
-        cpg->lines_capacity *= 2;
+        while (line >= cpg->lines_capacity) cpg->lines_capacity *= 2;
         // NOTE: we assume this only copies the pointers, not the data in the CPLs
-        cpg->lines = PyMem_Realloc(cpg->lines,
+        cpg->lines = PyMem_RawRealloc(cpg->lines,
                 sizeof(AK_CodePointLine*) * cpg->lines_capacity);
         if (cpg->lines == NULL) return -1;
     }
-    // Create the new CPL; first check if we need to set type_parse by calling into the dtypes function. For now we assume sequential growth, so should only check if equal
+    // With fields not selected skipped while tokenizing, lines can be skipped; as those lines are not selected, they are left as NULL placeholders (or as retained CPLs) and are not converted
+    for (; cpg->lines_allocated < line; ++cpg->lines_allocated) {
+        cpg->lines[cpg->lines_allocated] = NULL;
+    }
+    // Create the new CPL; first check if we need to set type_parse by calling into the dtypes function
     if (AK_UNLIKELY(line >= lines_count)) {
         // determine if we need to parse types
         bool type_parse = false;
-        if (cpg->dtypes == NULL) {
+        // with discard, a line of a given datetime dtype without a unit finds the unit of its fields
+        int dt_unit = AK_CPL_DT_UNIT_UNTRACKED;
+        if (cpg->dtypes_array != NULL) {
+            type_parse = AK_CPG_dtypes_array_parse(cpg, line + cpg->line_offset);
+            if (!type_parse && cpg->discard
+                    && AK_dtype_generic_datetime(cpg->dtypes_array[line + cpg->line_offset])) {
+                dt_unit = NPY_FR_GENERIC;
+            }
+        }
+        else if (cpg->dtypes == NULL) {
             type_parse = true;
         }
         else {
-            PyObject* line_count = PyLong_FromSsize_t(line);
+            PyObject* line_count = PyLong_FromSsize_t(line + cpg->line_offset);
             if (line_count == NULL) return -1;
 
             PyObject* dtype_specifier = PyObject_CallFunctionObjArgs(
@@ -2144,22 +5220,72 @@ AK_CPG_resize(AK_CodePointGrid* cpg, Py_ssize_t line)
             if (dtype_specifier == NULL) {
                 // NOTE: not sure how to get the exception from the failed call...
                 PyErr_Format(PyExc_RuntimeError,
-                        "dtypes callable failed for input: %d",
-                        line
+                        "dtypes callable failed for input: %zd",
+                        line + cpg->line_offset
                         );
                 return -1;
             }
             if (dtype_specifier == Py_None) {
                 type_parse = true;
             }
+            else if (cpg->discard) {
+                PyArray_Descr *dtype = NULL;
+                if (AK_DTypeFromSpecifier(dtype_specifier, &dtype)) {
+                    Py_DECREF(dtype_specifier);
+                    return -1;
+                }
+                if (AK_dtype_generic_datetime(dtype)) dt_unit = NPY_FR_GENERIC;
+                Py_XDECREF(dtype);
+            }
             Py_DECREF(dtype_specifier);
         }
-        // Always initialize a CPL in the new position
-        AK_CodePointLine *cpl = AK_CPL_New(type_parse, cpg->tsep, cpg->decc);
-        if (cpl == NULL) return -1; // memory error set
+        // a line of a dtype given in dtypes_array might be converted while tokenizing
+        char typed = '\0';
+        if (!type_parse && cpg->dtypes_array != NULL && !cpg->discard) {
+            typed = AK_CPL_typed_kind(cpg->dtypes_array[line + cpg->line_offset]);
+        }
+        if (line < cpg->lines_allocated && cpg->lines[line] != NULL) {
+            // reuse a CPL retained after AK_CPG_Clear
+            if (AK_CPL_Reset(cpg->lines[line], type_parse, cpg->tsep, cpg->decc)) return -1;
+            cpg->lines[line]->typed = typed;
+            cpg->lines[line]->dt_unit = dt_unit;
+            cpg->lines_count = line + 1;
+            return 0;
+        }
+        // Always initialize a CPL in the new position. When loading with axis 0, each record is a line and neighboring records tend to be of similar size; sizing from the previous line keeps memory proportional to the data rather than allocating a large fixed buffer per record. When loading with axis 1, lines start small and grow by doubling.
+        Py_ssize_t buffer_capacity = AK_CPL_BUFFER_CAPACITY_MIN;
+        Py_ssize_t offsets_capacity = AK_CPL_OFFSETS_CAPACITY_MIN;
+        AK_CodePointLine *previous = line > 0 ? cpg->lines[line - 1] : NULL;
+        if (previous) {
+            buffer_capacity = AK_CPL_capacity(previous->buffer_count, buffer_capacity);
+            offsets_capacity = AK_CPL_capacity(previous->offsets_count, offsets_capacity);
+        }
+        // with a fields capacity, offsets (or typed values) are sized once
+        if (cpg->fields_capacity > 0 && !typed && !cpg->discard) {
+            offsets_capacity = cpg->fields_capacity;
+        }
+        AK_CodePointLine *cpl = AK_CPL_New(type_parse,
+                cpg->tsep,
+                cpg->decc,
+                buffer_capacity,
+                offsets_capacity);
+        if (cpl == NULL) return -1;
+        cpl->na_values = cpg->na_values;
+        cpl->discard = cpg->discard;
+        cpl->dt_unit = dt_unit;
+        cpl->typed = typed;
+        if (typed && cpg->fields_capacity > 0) {
+            cpl->values = PyMem_RawMalloc((typed == 'b' ? 1 : 8) * cpg->fields_capacity);
+            if (cpl->values == NULL) {
+                AK_CPL_Free(cpl);
+                return -1;
+            }
+            cpl->values_capacity = cpg->fields_capacity;
+        }
 
         cpg->lines[line] = cpl;
-        ++cpg->lines_count;
+        cpg->lines_count = line + 1;
+        if (line == cpg->lines_allocated) ++cpg->lines_allocated;
     }
     return 0;
 }
@@ -2178,6 +5304,21 @@ AK_CPG_AppendPointAtLine(
     return 0;
 }
 
+// Append ASCII points on the line. Return 0 on success, -1 on failure.
+static inline int
+AK_CPG_AppendPointsAtLine(
+        AK_CodePointGrid* cpg,
+        Py_ssize_t line,
+        Py_ssize_t field_len,
+        const Py_UCS1 *p,
+        Py_ssize_t count
+        )
+{
+    if (AK_CPG_resize(cpg, line)) return -1;
+    if (AK_CPL_AppendPoints(cpg->lines[line], p, count, field_len)) return -1;
+    return 0;
+}
+
 // Append an offset in a line. Returns 0 on success, -1 on failure.
 static inline int
 AK_CPG_AppendOffsetAtLine(
@@ -2191,16 +5332,123 @@ AK_CPG_AppendOffsetAtLine(
     return 0;
 }
 
-// Given a fully-loaded CodePointGrid, process each CodePointLine into an array and return a new list of those arrays. Returns NULL on failure.
+// An array created with the GIL, to be filled from a CPL on a thread.
+typedef struct AK_CPLArrayFill {
+    AK_CodePointLine *cpl;
+    PyArrayObject *array;
+    Py_ssize_t index; // position in the list
+    int status;
+} AK_CPLArrayFill;
+
+typedef struct AK_CPLArrayFills {
+    AK_CPLArrayFill *fills;
+    char tsep;
+    char decc;
+} AK_CPLArrayFills;
+
+// Called without the GIL.
+static void
+AK_CPL_array_fill_parallel(void *context, Py_ssize_t i)
+{
+    AK_CPLArrayFills *fills = (AK_CPLArrayFills*)context;
+    AK_CPLArrayFill *fill = fills->fills + i;
+    fill->status = AK_CPL_array_fill(fill->cpl, fill->array, fills->tsep, fills->decc);
+}
+
+// Fill the arrays of `count` fills on up to `threads` threads without the GIL, then complete each in line order, replacing arrays in `list` (by fill index) as needed. Returns 0 on success, -1 on the error of the first line that failed.
+static int
+AK_CPL_array_fills_complete(AK_CPLArrayFills *fills,
+        Py_ssize_t count,
+        int threads,
+        PyObject *list)
+{
+    Py_BEGIN_ALLOW_THREADS
+    AK_ParallelFor(count, threads, AK_CPL_array_fill_parallel, fills);
+    Py_END_ALLOW_THREADS
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        AK_CPLArrayFill *fill = fills->fills + i;
+        PyObject *array = (PyObject*)fill->array;
+        Py_INCREF(array); // the list keeps its reference until replaced
+        array = AK_CPL_array_complete(fill->cpl, array, fill->status);
+        if (array == NULL) return -1;
+        if (array == (PyObject*)fill->array) {
+            Py_DECREF(array);
+        }
+        else {
+            PyList_SetItem(list, fill->index, array); // steals reference
+        }
+    }
+    return 0;
+}
+
+// Set `dtype` to a fresh dtype given by dtypes for line `i`, or, for a type parsed line, to a narrowed dtype if narrowing; otherwise, set `dtype` to NULL, such that the dtype is resolved from the CPL's type parser. Returns 0 on success, -1 on error.
+static int
+AK_CPG_line_dtype(AK_CodePointGrid* cpg, Py_ssize_t i, PyArray_Descr** dtype)
+{
+    *dtype = NULL;
+    if (cpg->dtypes_array != NULL) {
+        Py_ssize_t line = i + cpg->line_offset;
+        if (!AK_CPG_dtypes_array_parse(cpg, line)) {
+            // a fresh instance, as it might be mutated
+            *dtype = PyArray_DescrNew(cpg->dtypes_array[line]);
+            if (*dtype == NULL) return -1;
+        }
+    }
+    else if (cpg->dtypes != NULL) {
+        // NOTE: we call this with i regardless of if we skipped a line
+        PyObject* line_count = PyLong_FromSsize_t(i + cpg->line_offset);
+        if (line_count == NULL) return -1;
+        PyObject* dtype_specifier = PyObject_CallFunctionObjArgs(
+                cpg->dtypes,
+                line_count,
+                NULL
+                );
+        Py_DECREF(line_count);
+        if (dtype_specifier == NULL) {
+            // NOTE: not sure how to get the exception from the failed call...
+            PyErr_Format(PyExc_RuntimeError,
+                    "dtypes callable failed for input: %zd",
+                    i + cpg->line_offset
+                    );
+            return -1;
+        }
+        if (dtype_specifier != Py_None) {
+            // Set dtype; this value can be NULL or a dtype (never Py_None); if dtype_specifier is Py_None, keep dtype set as NULL (above); this will be a new reference that if used will be stolen in array construction.
+            if (AK_DTypeFromSpecifier(dtype_specifier, dtype)) {
+                Py_DECREF(dtype_specifier);
+                return -1;
+            }
+        }
+        Py_DECREF(dtype_specifier);
+    }
+    AK_CodePointLine* cpl = cpg->lines[i];
+    if (*dtype == NULL && cpl->type_parser
+            && (cpg->narrow_int || cpg->narrow_float)) {
+        *dtype = AK_TP_ToDtype(cpl->type_parser, cpg->narrow_int, cpg->narrow_float);
+        if (*dtype == NULL) return -1;
+    }
+    return 0;
+}
+
+// Given a fully-loaded CodePointGrid, process each CodePointLine into an array and return a new list of those arrays. If `threads` is greater than one, arrays of dtypes that permit C-only buffer transfers are created while iterating over lines, then filled together on threads without the GIL. If `categorical` is not NULL, lines it selects that are of a unicode dtype are returned as a tuple of codes and unique values. Returns NULL on failure.
 PyObject* AK_CPG_ToArrayList(AK_CodePointGrid* cpg,
         int axis,
-        PyObject* line_select,
+        AK_LineSelect* line_select,
+        AK_LineSelect* categorical,
         char tsep,
-        char decc)
+        char decc,
+        int threads)
 {
-    bool ls_inactive = line_select == NULL;
+    bool ls_inactive = AK_LS_inactive(line_select) || axis != 1;
     PyObject *list;
 
+    AK_CPLArrayFills fills = {NULL, tsep, decc};
+    Py_ssize_t fills_count = 0;
+    if (threads > 1 && cpg->lines_count > 1) {
+        fills.fills = (AK_CPLArrayFill*)PyMem_Malloc(sizeof(AK_CPLArrayFill) * cpg->lines_count);
+        if (fills.fills == NULL) return PyErr_NoMemory();
+    }
+
     if (ls_inactive) {
         // if we know how many lines we will need, can pre-allocate
         list = PyList_New(cpg->lines_count);
@@ -2208,62 +5456,57 @@ PyObject* AK_CPG_ToArrayList(AK_CodePointGrid* cpg,
     else {
         list = PyList_New(0);
     }
-    if (list == NULL) return NULL;
-
-    PyObject* dtypes = cpg->dtypes;
+    if (list == NULL) goto error;
 
     // Iterate over lines in the code point grid
     for (Py_ssize_t i = 0; i < cpg->lines_count; ++i) {
         // if axis is axis 1, apply keep
-        switch (AK_line_select_keep(line_select, 1 == axis, i)) {
-            case -1:
-                Py_DECREF(list);
-                return NULL;
-            case 0:
-                continue;
-        }
-        // If dtypes is not NULL, fetch the dtype_specifier and use it to set dtype; else, pass the dtype as NULL to CPL.
-        PyArray_Descr* dtype = NULL;
-
-        if (dtypes != NULL) {
-            // NOTE: we call this with i regardless of if we skipped a line
-            PyObject* line_count = PyLong_FromSsize_t(i);
-            if (line_count == NULL) {
-                Py_DECREF(list);
-                return NULL;
-            }
-            PyObject* dtype_specifier = PyObject_CallFunctionObjArgs(
-                    dtypes,
-                    line_count,
-                    NULL
-                    );
-            Py_DECREF(line_count);
-            if (dtype_specifier == NULL) {
-                Py_DECREF(list);
-                // NOTE: not sure how to get the exception from the failed call...
-                PyErr_Format(PyExc_RuntimeError,
-                        "dtypes callable failed for input: %d",
-                        i
-                        );
-                return NULL;
+        if (!ls_inactive) {
+            switch (AK_LS_field_keep(line_select, i)) {
+                case -1:
+                    goto error;
+                case 0:
+                    continue;
             }
-            if (dtype_specifier != Py_None) {
-                // Set dtype; this value can be NULL or a dtype (never Py_None); if dtype_specifier is Py_None, keep dtype set as NULL (above); this will be a new reference that if used will be stolen in array construction.
-                if (AK_DTypeFromSpecifier(dtype_specifier, &dtype)) {
-                    Py_DECREF(dtype_specifier);
-                    Py_DECREF(list);
-                    return NULL;
-                }
+        }
+        // a line not selected might have been skipped while tokenizing
+        if (cpg->lines[i] == NULL) continue;
+        PyArray_Descr* dtype;
+        if (AK_CPG_line_dtype(cpg, i, &dtype)) goto error;
+        PyObject* array;
+        AK_CodePointLine* cpl = cpg->lines[i];
+        bool deferred = false;
+        int encode = 0;
+        if (categorical != NULL) {
+            encode = AK_LS_field_keep(categorical, i);
+            if (encode < 0) {
+                Py_XDECREF(dtype);
+                goto error;
             }
-            Py_DECREF(dtype_specifier);
         }
-        // This function will observe if dtype is NULL and read dtype from the CPL's type_parser if necessary
-        // NOTE: this might be multi-threadable for dtypes that permit C-only buffer transfers
-        PyObject* array = AK_CPL_ToArray(cpg->lines[i], dtype, tsep, decc);
-        if (array == NULL) {
+        if (fills.fills || encode) {
+            dtype = AK_CPL_resolve_dtype(cpl, dtype);
+            if (dtype == NULL) goto error;
+        }
+        if (encode && dtype->kind == 'U') {
+            array = AK_CPL_ToCategorical(cpl, dtype);
+            if (array == NULL) goto error;
+        }
+        else if (fills.fills && AK_CPL_array_native(dtype->kind)) {
+            // create the array now, fill it on a thread after all lines are processed
+            array = AK_CPL_array_new(cpl, dtype);
+            if (array == NULL) goto error;
+            AK_CPLArrayFill *fill = fills.fills + fills_count;
+            fill->cpl = cpl;
+            fill->array = (PyArrayObject*)array; // borrowed, as owned by list
+            fill->index = ls_inactive ? i : PyList_GET_SIZE(list);
+            deferred = true;
+        }
+        else {
+            // This function will observe if dtype is NULL and read dtype from the CPL's type_parser if necessary
+            array = AK_CPL_ToArray(cpl, dtype, tsep, decc);
             // if array creation has been aborted due to a bad character, we will already have decrefed the array
-            Py_DECREF(list);
-            return NULL;
+            if (array == NULL) goto error;
         }
 
         if (ls_inactive) {
@@ -2272,13 +5515,72 @@ PyObject* AK_CPG_ToArrayList(AK_CodePointGrid* cpg,
         else {
             if (PyList_Append(list, array)) {
                 Py_DECREF(array);
-                Py_DECREF(list);
-                return NULL;
+                goto error;
             }
             Py_DECREF(array); // decref as list owns
         }
+        // counted once owned by the list
+        if (deferred) ++fills_count;
+    }
+    if (fills_count && AK_CPL_array_fills_complete(&fills, fills_count, threads, list)) {
+        fills_count = 0; // already completed
+        goto error;
+    }
+    PyMem_Free(fills.fills);
+    return list;
+error:
+    if (fills_count && PyErr_Occurred()) {
+        // a later line failed; raise the error of a deferred line before it, if any, as would be found converting serially
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        if (AK_CPL_array_fills_complete(&fills, fills_count, threads, list)) {
+            Py_XDECREF(type);
+            Py_XDECREF(value);
+            Py_XDECREF(traceback);
+        }
+        else {
+            PyErr_Restore(type, value, traceback);
+        }
+    }
+    Py_XDECREF(list);
+    PyMem_Free(fills.fills);
+    return NULL;
+}
+
+// Given a CodePointGrid loaded with `discard`, return a new list of the dtype of each line selected by `line_select`, as AK_CPG_ToArrayList would create for axis 1. As with AK_CPL_array_new, unicode and bytes dtypes without an itemsize are given the itemsize of the longest field, and datetime dtypes without a unit are given the finest unit found. Returns NULL on failure.
+PyObject* AK_CPG_ToDtypeList(AK_CodePointGrid* cpg, AK_LineSelect* line_select)
+{
+    PyObject *list = PyList_New(0);
+    if (list == NULL) return NULL;
+
+    for (Py_ssize_t i = 0; i < cpg->lines_count; ++i) {
+        switch (AK_LS_field_keep(line_select, i)) {
+            case -1:
+                goto error;
+            case 0:
+                continue;
+        }
+        AK_CodePointLine* cpl = cpg->lines[i];
+        if (cpl == NULL) continue;
+        PyArray_Descr* dtype;
+        if (AK_CPG_line_dtype(cpg, i, &dtype)) goto error;
+        dtype = AK_CPL_resolve_dtype(cpl, dtype);
+        if (dtype == NULL) goto error;
+        if ((dtype->kind == 'U' || dtype->kind == 'S') && dtype->elsize == 0) {
+            AK_CPL_size_dtype(cpl, dtype);
+        }
+        else if (AK_dtype_generic_datetime(dtype) && cpl->dt_unit >= 0) {
+            AK_datetime_meta(dtype)->base = (NPY_DATETIMEUNIT)cpl->dt_unit;
+            AK_datetime_meta(dtype)->num = 1;
+        }
+        int status = PyList_Append(list, (PyObject*)dtype);
+        Py_DECREF(dtype);
+        if (status) goto error;
     }
     return list;
+error:
+    Py_DECREF(list);
+    return NULL;
 }
 
 //------------------------------------------------------------------------------
@@ -2450,9 +5752,219 @@ typedef enum AK_DelimitedReaderState {
     AFTER_ESCAPED_CRNL
 } AK_DelimitedReaderState;
 
+// Errors found while tokenizing are recorded on the AK_DelimitedReader such that they can be raised later by a thread that holds the GIL.
+typedef enum AK_DelimitedReaderError {
+    DRE_NONE,
+    DRE_MEMORY,
+    DRE_QUOTE_IN_QUOTED_FIELD,
+    DRE_NEWLINE_IN_FIELD,
+    DRE_END_OF_DATA,
+    DRE_DECODE,
+    DRE_READ,
+    DRE_INFLATE,
+} AK_DelimitedReaderError;
+
+# define AK_DR_STOPS 5
+
+// The number of bytes requested from a binary file object with each call to readinto.
+# define AK_DR_STREAM_BLOCK 1048576
+
+// The initial number of bytes reserved before each block read, such that a partial line carried over from the previous block can be copied in front of it; doubled as needed for longer lines.
+# define AK_DR_STREAM_HEAD 16384
+
+// Input from a binary file object is read in blocks with `readinto` into one of two buffers. While the current buffer is tokenized, the next block is read into the other buffer by a reader thread, started once per stream; that thread takes the GIL to call `readinto`, such that reading overlaps tokenizing only while the GIL is released.
+typedef struct AK_DR_Stream {
+    PyObject *readinto; // bound method of the file object
+    char *buffers[2];
+    Py_ssize_t heads[2]; // bytes reserved at the start of each buffer, before the block read
+    Py_ssize_t capacities[2]; // bytes read into each buffer after its head
+    int current; // the buffer being tokenized; the other is the target of reads
+    bool pending; // a read is in progress on the background thread
+    bool eof;
+    bool gil_released; // if true, waiting for a read does not need to release the GIL
+    PyThread_type_lock done; // held while a read is pending
+    PyThread_type_lock request; // held until a read is requested of the reader thread
+    PyThread_type_lock exited; // held while the reader thread runs
+    bool stop; // the reader thread exits on its next request
+    Py_ssize_t read_count; // bytes read by the last read, or -1 on error
+    PyObject *error_type; // the exception of a failed read
+    PyObject *error_value;
+    PyObject *error_tb;
+    bool started; // the first block has been read
+# ifdef AK_ZLIB
+    // gzip input, detected from the first two bytes read, is inflated from the read buffers into `inflated`
+    z_stream *zs;
+    char *inflated;
+    Py_ssize_t inflated_capacity;
+    bool raw_eof; // all compressed input has been read
+    bool member_end; // the end of a gzip member was inflated
+    bool inflate_full; // the last inflate filled its output, and might have more output pending
+# endif
+} AK_DR_Stream;
+
+// Return the start of the block read into buffer `i`, after its head.
+static inline char*
+AK_DR_stream_block(AK_DR_Stream *stream, int i)
+{
+    return stream->buffers[i] + stream->heads[i];
+}
+
+// Read a block into the buffer that is not current; called on the reader thread without the GIL.
+static void
+AK_DR_stream_read(void *arg)
+{
+    AK_DR_Stream *stream = (AK_DR_Stream*)arg;
+    int target = 1 - stream->current;
+    Py_ssize_t count = -1;
+
+    PyGILState_STATE gil = PyGILState_Ensure();
+    PyObject *view = PyMemoryView_FromMemory(AK_DR_stream_block(stream, target),
+            stream->capacities[target],
+            PyBUF_WRITE);
+    if (view != NULL) {
+        PyObject *result = PyObject_CallFunctionObjArgs(stream->readinto, view, NULL);
+        Py_DECREF(view);
+        if (result != NULL) {
+            count = PyLong_Check(result) ? PyLong_AsSsize_t(result) : -1;
+            if (count < 0 || count > stream->capacities[target]) {
+                if (!PyErr_Occurred()) {
+                    PyErr_SetString(PyExc_ValueError,
+                            "readinto must return the count of bytes read; non-blocking streams are not supported");
+                }
+                count = -1;
+            }
+            Py_DECREF(result);
+        }
+    }
+    if (count < 0) {
+        PyErr_Fetch(&stream->error_type, &stream->error_value, &stream->error_tb);
+    }
+    stream->read_count = count;
+    PyGILState_Release(gil);
+    PyThread_release_lock(stream->done);
+}
+
+// The reader thread reads a block for each request until stopped. As the GIL is only taken for each read, an idle reader thread can exit without it.
+static void
+AK_DR_stream_reader(void *arg)
+{
+    AK_DR_Stream *stream = (AK_DR_Stream*)arg;
+    while (true) {
+        PyThread_acquire_lock(stream->request, WAIT_LOCK);
+        if (stream->stop) break;
+        AK_DR_stream_read(stream);
+    }
+    PyThread_release_lock(stream->exited);
+}
+
+// Request the next block of the reader thread. Does not require the GIL.
+static void
+AK_DR_stream_start(AK_DR_Stream *stream)
+{
+    PyThread_acquire_lock(stream->done, NOWAIT_LOCK);
+    stream->pending = true;
+    PyThread_release_lock(stream->request);
+}
+
+// Wait for a pending read to complete. If the GIL is held, it is released while waiting, as the reading thread needs it.
+static void
+AK_DR_stream_wait(AK_DR_Stream *stream)
+{
+    if (!stream->pending) return;
+    if (stream->gil_released) {
+        PyThread_acquire_lock(stream->done, WAIT_LOCK);
+    }
+    else {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(stream->done, WAIT_LOCK);
+        Py_END_ALLOW_THREADS
+    }
+    PyThread_release_lock(stream->done);
+    stream->pending = false;
+}
+
+// Must be called with the GIL; a pending read is completed first, and the reader thread, if started, is joined.
+static void
+AK_DR_stream_free(AK_DR_Stream *stream)
+{
+    if (stream->exited != NULL) {
+        AK_DR_stream_wait(stream);
+        stream->stop = true;
+        PyThread_release_lock(stream->request);
+        PyThread_acquire_lock(stream->exited, WAIT_LOCK);
+        PyThread_release_lock(stream->exited);
+        PyThread_free_lock(stream->exited);
+    }
+    if (stream->request != NULL) PyThread_free_lock(stream->request);
+    if (stream->done != NULL) PyThread_free_lock(stream->done);
+# ifdef AK_ZLIB
+    if (stream->zs != NULL) {
+        inflateEnd(stream->zs);
+        PyMem_RawFree(stream->zs);
+    }
+    PyMem_RawFree(stream->inflated);
+# endif
+    Py_XDECREF(stream->readinto);
+    Py_XDECREF(stream->error_type);
+    Py_XDECREF(stream->error_value);
+    Py_XDECREF(stream->error_tb);
+    PyMem_RawFree(stream->buffers[0]);
+    PyMem_RawFree(stream->buffers[1]);
+    PyMem_Free(stream);
+}
+
+// Return a new AK_DR_Stream reading from `readinto`, with the first block being read. Returns NULL on error.
+static AK_DR_Stream*
+AK_DR_stream_new(PyObject *readinto)
+{
+    AK_DR_Stream *stream = (AK_DR_Stream*)PyMem_Calloc(1, sizeof(AK_DR_Stream));
+    if (stream == NULL) return (AK_DR_Stream*)PyErr_NoMemory();
+    Py_INCREF(readinto);
+    stream->readinto = readinto;
+    for (int i = 0; i < 2; ++i) {
+        stream->heads[i] = AK_DR_STREAM_HEAD;
+        stream->capacities[i] = AK_DR_STREAM_BLOCK;
+        stream->buffers[i] = (char*)PyMem_RawMalloc(AK_DR_STREAM_HEAD + AK_DR_STREAM_BLOCK);
+        if (stream->buffers[i] == NULL) {
+            AK_DR_stream_free(stream);
+            return (AK_DR_Stream*)PyErr_NoMemory();
+        }
+    }
+    stream->done = PyThread_allocate_lock();
+    stream->request = PyThread_allocate_lock();
+    PyThread_type_lock exited = PyThread_allocate_lock();
+    if (stream->done == NULL || stream->request == NULL || exited == NULL) {
+        if (exited != NULL) PyThread_free_lock(exited);
+        AK_DR_stream_free(stream);
+        return (AK_DR_Stream*)PyErr_NoMemory();
+    }
+    PyThread_acquire_lock(stream->request, WAIT_LOCK);
+    PyThread_acquire_lock(exited, WAIT_LOCK);
+    if (PyThread_start_new_thread(AK_DR_stream_reader, stream) == PYTHREAD_INVALID_THREAD_ID) {
+        PyThread_free_lock(exited);
+        AK_DR_stream_free(stream);
+        PyErr_SetString(PyExc_RuntimeError, "can't start new thread");
+        return NULL;
+    }
+    stream->exited = exited; // only set once the reader thread is started, as it must then be joined
+    AK_DR_stream_start(stream);
+    return stream;
+}
+
 typedef struct AK_DelimitedReader{
     PyObject *input_iter;
-    PyObject *line_select;
+    Py_buffer input_view; // only set if reading from an object that exports the buffer protocol
+    AK_DR_Stream *stream; // only set if reading from a binary file object
+    const char *input_pos; // current position in input_view, or in the current stream buffer
+    const char *input_end;
+    AK_LineSelect *field_select; // for axis 1, a line_select applied to fields while tokenizing; otherwise NULL
+    bool field_keep; // if false, characters of the current field are not stored
+    Py_ssize_t field_select_number; // field for which field_keep was determined, or -1
+    Py_ssize_t skiprows; // records still to be skipped at the start of the input
+    Py_ssize_t nrows_remaining; // records still to be loaded, or -1 if unlimited
+    AK_RowFilter *row_filter; // NULL, or tests applied to each record before it is added to the CPG
+    AK_CodePointGrid *stage; // with a row_filter, the fields of the current record, on line stage_line
+    Py_ssize_t stage_line; // always 0
     AK_Dialect *dialect;
     AK_DelimitedReaderState state;
     Py_ssize_t field_len;
@@ -2461,15 +5973,277 @@ typedef struct AK_DelimitedReader{
     Py_ssize_t field_number; // field in current record, reset for each record
     int axis;
     Py_ssize_t *axis_pos; // points to either record_number or field_number
+    bool defer_error; // if true, errors are recorded but not raised
+    AK_DelimitedReaderError error;
+    const char *error_line; // for DRE_DECODE, the line that could not be decoded
+    const char *error_line_end;
+    // ASCII characters that end a run of ordinary characters in an unquoted or quoted field; unused positions are '\0'
+    Py_UCS1 field_stops[AK_DR_STOPS];
+    Py_UCS1 quoted_stops[AK_DR_STOPS];
+    // lines without quote or escape characters can be split on the delimiter without the state machine; `split_checks` are the characters that must be absent, or empty if quoting is QUOTE_NONE and there is no escapechar
+    bool split;
+    Py_ssize_t split_checks_count;
+    Py_UCS1 split_checks[2];
+    Py_UCS1 split_stops[AK_DR_STOPS];
 } AK_DelimitedReader;
 
+// Set an exception for the error recorded on the AK_DelimitedReader. Must be called with the GIL.
+static void
+AK_DR_RaiseError(AK_DelimitedReader *dr)
+{
+    switch (dr->error) {
+        case DRE_NONE:
+        case DRE_MEMORY:
+            // the dtypes callable might have already set an exception
+            if (!PyErr_Occurred()) PyErr_NoMemory();
+            break;
+        case DRE_QUOTE_IN_QUOTED_FIELD:
+            PyErr_Format(PyExc_RuntimeError, "'%c' expected after '%c'",
+                    dr->dialect->delimiter, dr->dialect->quotechar);
+            break;
+        case DRE_NEWLINE_IN_FIELD:
+            PyErr_Format(PyExc_RuntimeError,
+                    "new-line character seen in unquoted field - do you need to open the file in universal-newline mode?");
+            break;
+        case DRE_END_OF_DATA:
+            PyErr_SetString(PyExc_RuntimeError, "unexpected end of data");
+            break;
+        case DRE_READ:
+            if (dr->stream->error_type != NULL) {
+                PyErr_Restore(dr->stream->error_type,
+                        dr->stream->error_value,
+                        dr->stream->error_tb);
+                dr->stream->error_type = NULL;
+                dr->stream->error_value = NULL;
+                dr->stream->error_tb = NULL;
+            }
+            else if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_RuntimeError, "readinto failed");
+            }
+            break;
+        case DRE_INFLATE:
+# ifdef AK_ZLIB
+            if (dr->stream->zs->msg != NULL) {
+                PyErr_Format(PyExc_ValueError, "invalid gzip data: %s", dr->stream->zs->msg);
+                break;
+            }
+# endif
+            PyErr_SetString(PyExc_ValueError, "invalid gzip data: compressed input ended early");
+            break;
+        case DRE_DECODE: {
+            // let CPython's decoder raise the UnicodeDecodeError for this line
+            PyObject *record = PyUnicode_DecodeUTF8(dr->error_line,
+                    dr->error_line_end - dr->error_line,
+                    NULL);
+            if (record != NULL) {
+                Py_DECREF(record);
+                PyErr_SetString(PyExc_ValueError, "invalid UTF-8 byte sequence");
+            }
+            break;
+        }
+    }
+}
+
+// Record an error, raising it unless errors are deferred. Always returns -1.
+static int
+AK_DR_error(AK_DelimitedReader *dr, AK_DelimitedReaderError error)
+{
+    dr->error = error;
+    if (!dr->defer_error) AK_DR_RaiseError(dr);
+    return -1;
+}
+
+# ifdef AK_ZLIB
+// Begin inflating gzip input from the unprocessed bytes of the current buffer, which are consumed. Returns 0 on success, -1 on failure.
+static int
+AK_DR_stream_inflate_init(AK_DelimitedReader *dr)
+{
+    AK_DR_Stream *stream = dr->stream;
+    stream->zs = (z_stream*)PyMem_RawCalloc(1, sizeof(z_stream));
+    if (stream->zs == NULL) return AK_DR_error(dr, DRE_MEMORY);
+    // 16 added to the window bits expects a gzip header and trailer
+    if (inflateInit2(stream->zs, 16 + MAX_WBITS) != Z_OK) {
+        PyMem_RawFree(stream->zs);
+        stream->zs = NULL;
+        return AK_DR_error(dr, DRE_MEMORY);
+    }
+    stream->zs->next_in = (Bytef*)dr->input_pos;
+    stream->zs->avail_in = (uInt)(dr->input_end - dr->input_pos);
+    dr->input_pos = dr->input_end;
+    return 0;
+}
+
+// Inflate gzip input after the unprocessed bytes, moved to the start of the inflated buffer. Compressed input is consumed from the current buffer; once exhausted, the next block is taken and another read started. Concatenated gzip members are inflated in sequence. Does not require the GIL. Returns the number of bytes inflated, or -1 on failure.
+static Py_ssize_t
+AK_DR_stream_inflate(AK_DelimitedReader *dr)
+{
+    AK_DR_Stream *stream = dr->stream;
+    z_stream *zs = stream->zs;
+    if (zs->avail_in == 0 && !stream->inflate_full) {
+        if (!stream->raw_eof) {
+            AK_DR_stream_wait(stream);
+            Py_ssize_t count = stream->read_count;
+            if (count < 0) return AK_DR_error(dr, DRE_READ);
+            if (count > 0) {
+                stream->current = 1 - stream->current;
+                zs->next_in = (Bytef*)AK_DR_stream_block(stream, stream->current);
+                zs->avail_in = (uInt)count;
+                AK_DR_stream_start(stream);
+            }
+            else {
+                stream->raw_eof = true;
+            }
+        }
+        if (stream->raw_eof) {
+            if (!stream->member_end) return AK_DR_error(dr, DRE_INFLATE);
+            stream->eof = true;
+            return 0;
+        }
+    }
+    Py_ssize_t tail = dr->input_end - dr->input_pos;
+    if (tail > 0) {
+        memmove(stream->inflated, dr->input_pos, tail);
+    }
+    if (stream->inflated_capacity - tail < AK_DR_STREAM_BLOCK) {
+        char *inflated = PyMem_RawRealloc(stream->inflated, tail + AK_DR_STREAM_BLOCK);
+        if (inflated == NULL) return AK_DR_error(dr, DRE_MEMORY);
+        stream->inflated = inflated;
+        stream->inflated_capacity = tail + AK_DR_STREAM_BLOCK;
+    }
+    if (stream->member_end) {
+        // input after the end of a member is another member
+        if (inflateReset(zs) != Z_OK) return AK_DR_error(dr, DRE_INFLATE);
+        stream->member_end = false;
+    }
+    uInt avail = (uInt)(stream->inflated_capacity - tail);
+    zs->next_out = (Bytef*)stream->inflated + tail;
+    zs->avail_out = avail;
+    switch (inflate(zs, Z_NO_FLUSH)) {
+        case Z_STREAM_END:
+            stream->member_end = true;
+            break;
+        case Z_OK:
+        case Z_BUF_ERROR: // no progress without more input
+            break;
+        case Z_MEM_ERROR:
+            return AK_DR_error(dr, DRE_MEMORY);
+        default:
+            return AK_DR_error(dr, DRE_INFLATE);
+    }
+    stream->inflate_full = zs->avail_out == 0;
+    Py_ssize_t count = avail - zs->avail_out;
+    dr->input_pos = stream->inflated;
+    dr->input_end = stream->inflated + tail + count;
+    return count;
+}
+# endif
+
+// With stream input, copy the unprocessed bytes of the current buffer, a partial line, into the head of the next buffer, before the next block read; repeat until a complete line is available or the input is exhausted. gzip input, detected by its magic number in the first two bytes read, is inflated. Does not require the GIL. Returns 0 on success, -1 on failure.
+static int
+AK_DR_stream_refill(AK_DelimitedReader *dr)
+{
+    AK_DR_Stream *stream = dr->stream;
+    Py_ssize_t tail;
+    Py_ssize_t count;
+    do {
+# ifdef AK_ZLIB
+        if (stream->zs != NULL) {
+            tail = dr->input_end - dr->input_pos;
+            count = AK_DR_stream_inflate(dr);
+            if (count < 0) return -1;
+            continue;
+        }
+# endif
+        AK_DR_stream_wait(stream);
+        count = stream->read_count;
+        if (count < 0) return AK_DR_error(dr, DRE_READ);
+        if (count == 0) stream->eof = true;
+
+        int next = 1 - stream->current;
+        char *block = AK_DR_stream_block(stream, next);
+        tail = dr->input_end - dr->input_pos;
+        if (tail > stream->heads[next]) {
+            // only for a partial line longer than the head: grow the head, moving the block
+            Py_ssize_t head = stream->heads[next];
+            while (head < tail) head *= 2;
+            char *buffer = (char*)PyMem_RawMalloc(head + stream->capacities[next]);
+            if (buffer == NULL) return AK_DR_error(dr, DRE_MEMORY);
+            memcpy(buffer + head, block, count);
+            PyMem_RawFree(stream->buffers[next]);
+            stream->buffers[next] = buffer;
+            stream->heads[next] = head;
+            block = buffer + head;
+        }
+        if (tail > 0) {
+            memcpy(block - tail, dr->input_pos, tail);
+        }
+        stream->current = next;
+        dr->input_pos = block - tail;
+        dr->input_end = block + count;
+        // the magic number is checked once two bytes are buffered, as reads might return fewer
+        if (!stream->started && (dr->input_end - dr->input_pos >= 2 || stream->eof)) {
+            stream->started = true;
+            const unsigned char *head = (const unsigned char*)dr->input_pos;
+            if (dr->input_end - dr->input_pos >= 2 && head[0] == 0x1f && head[1] == 0x8b) {
+# ifdef AK_ZLIB
+                if (AK_DR_stream_inflate_init(dr)) return -1;
+                tail = 0;
+                count = 0;
+# else
+                PyGILState_STATE gil = PyGILState_Ensure();
+                PyErr_SetString(PyExc_NotImplementedError,
+                        "gzip input requires arraykit built with zlib");
+                PyErr_Fetch(&stream->error_type, &stream->error_value, &stream->error_tb);
+                PyGILState_Release(gil);
+                return AK_DR_error(dr, DRE_READ);
+# endif
+            }
+        }
+        // the previous buffer is now free to be the target of the next read
+        if (!stream->eof) AK_DR_stream_start(stream);
+    } while (!stream->eof && (!stream->started
+            || memchr(dr->input_pos + tail, '\n', count) == NULL));
+    return 0;
+}
+
+// For buffer or stream input, set `line` and `line_end` to the next line, which is terminated by (and includes) a newline, or by the end of the input. Does not require the GIL. Returns 1 if a line was found, 0 at the end of input, -1 on failure.
+static inline int
+AK_DR_next_line(AK_DelimitedReader *dr, const char **line, const char **line_end)
+{
+    const char *nl = memchr(dr->input_pos, '\n', dr->input_end - dr->input_pos);
+    if (nl == NULL && dr->stream != NULL && !dr->stream->eof) {
+        if (AK_DR_stream_refill(dr)) return -1;
+        nl = memchr(dr->input_pos, '\n', dr->input_end - dr->input_pos);
+    }
+    if (dr->input_pos >= dr->input_end) return 0;
+    *line = dr->input_pos;
+    *line_end = nl == NULL ? dr->input_end : nl + 1;
+    dr->input_pos = *line_end;
+    return 1;
+}
+
+// With a line_select applied to fields, determine field_keep on the first character or close of each field, such that line_select is only called for fields that exist. Returns 0 on success, -1 on failure.
+static inline int
+AK_DR_field_select(AK_DelimitedReader *dr)
+{
+    if (AK_LIKELY(dr->field_select == NULL
+            || dr->field_select_number == dr->field_number)) return 0;
+    int keep = AK_LS_field_keep(dr->field_select, dr->field_number);
+    // a failed callable has set an exception, which is preserved
+    if (keep < 0) return AK_DR_error(dr, DRE_MEMORY);
+    dr->field_keep = keep;
+    dr->field_select_number = dr->field_number;
+    return 0;
+}
+
 // Called once at the close of each field in a line. Returns 0 on success, -1 on failure
 static inline int
 AK_DR_close_field(AK_DelimitedReader *dr, AK_CodePointGrid *cpg)
 {
-    if (AK_CPG_AppendOffsetAtLine(cpg,
+    if (AK_DR_field_select(dr)) return -1;
+    if (dr->field_keep && AK_CPG_AppendOffsetAtLine(cpg,
             *(dr->axis_pos),
-            dr->field_len)) return -1;
+            dr->field_len)) return AK_DR_error(dr, DRE_MEMORY);
     dr->field_len = 0; // clear to close
     // AK_DEBUG_MSG_OBJ("closing field", PyLong_FromLong(dr->field_number));
     ++dr->field_number; // increment after adding each offset, reset in AK_DR_line_reset
@@ -2480,15 +6254,100 @@ AK_DR_close_field(AK_DelimitedReader *dr, AK_CodePointGrid *cpg)
 static inline int
 AK_DR_add_char(AK_DelimitedReader *dr, AK_CodePointGrid *cpg, Py_UCS4 c)
 {
-    // NOTE: ideally we could use line_select here; however, we would need to cache the lookup in another container as this is called once per char and line_select is a Python function; further, we would need to increment the field_number separately from another counter, which is done in AK_DR_close_field
-    if (AK_CPG_AppendPointAtLine(cpg,
+    // fields not selected are counted in field_len but not stored
+    if (AK_DR_field_select(dr)) return -1;
+    if (dr->field_keep && AK_CPG_AppendPointAtLine(cpg,
             *(dr->axis_pos),
             dr->field_len,
-            c)) return -1;
+            c)) return AK_DR_error(dr, DRE_MEMORY);
     ++dr->field_len; // reset in AK_DR_close_field
     return 0;
 }
 
+// Called to add a run of ordinary ASCII characters within a field. Return 0 on success, -1 on failure.
+static inline int
+AK_DR_add_chars(AK_DelimitedReader *dr,
+        AK_CodePointGrid *cpg,
+        const Py_UCS1 *p,
+        Py_ssize_t count)
+{
+    if (AK_DR_field_select(dr)) return -1;
+    if (dr->field_keep && AK_CPG_AppendPointsAtLine(cpg,
+            *(dr->axis_pos),
+            dr->field_len,
+            p,
+            count)) return AK_DR_error(dr, DRE_MEMORY);
+    dr->field_len += count;
+    return 0;
+}
+
+static inline int
+AK_ctz(unsigned int x)
+{
+# if defined _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return (int)i;
+# else
+    return __builtin_ctz(x);
+# endif
+}
+
+// Return a pointer to the first character in `p` to `end` that is either one of the `stops` or not ASCII; returns `end` if there is no such character. With SSE2 or AVX2, 16 or 32 characters are compared at a time.
+static inline const Py_UCS1*
+AK_DR_scan_run(const Py_UCS1 *p, const Py_UCS1 *end, const Py_UCS1 *stops)
+{
+# if AK_AVX2
+    {
+        __m256i s0 = _mm256_set1_epi8((char)stops[0]);
+        __m256i s1 = _mm256_set1_epi8((char)stops[1]);
+        __m256i s2 = _mm256_set1_epi8((char)stops[2]);
+        __m256i s3 = _mm256_set1_epi8((char)stops[3]);
+        __m256i s4 = _mm256_set1_epi8((char)stops[4]);
+        while (end - p >= 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)p);
+            __m256i m = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, s0), _mm256_cmpeq_epi8(v, s1)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, s2), _mm256_cmpeq_epi8(v, s3)));
+            m = _mm256_or_si256(_mm256_or_si256(m, _mm256_cmpeq_epi8(v, s4)), v);
+            // the high bit is set for matches and non-ASCII characters
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(m);
+            if (mask) return p + AK_ctz(mask);
+            p += 32;
+        }
+    }
+# endif
+# if AK_SSE2
+    {
+        __m128i s0 = _mm_set1_epi8((char)stops[0]);
+        __m128i s1 = _mm_set1_epi8((char)stops[1]);
+        __m128i s2 = _mm_set1_epi8((char)stops[2]);
+        __m128i s3 = _mm_set1_epi8((char)stops[3]);
+        __m128i s4 = _mm_set1_epi8((char)stops[4]);
+        while (end - p >= 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            __m128i m = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, s0), _mm_cmpeq_epi8(v, s1)),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, s2), _mm_cmpeq_epi8(v, s3)));
+            m = _mm_or_si128(_mm_or_si128(m, _mm_cmpeq_epi8(v, s4)), v);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(m);
+            if (mask) return p + AK_ctz(mask);
+            p += 16;
+        }
+    }
+# endif
+    for (; p < end; ++p) {
+        Py_UCS1 c = *p;
+        if (c >= 0x80
+                || c == stops[0]
+                || c == stops[1]
+                || c == stops[2]
+                || c == stops[3]
+                || c == stops[4]) break;
+    }
+    return p;
+}
+
 // Process each char and update AK_DelimitedReader state. When appropriate, call AK_DR_add_char to accumulate field characters, AK_DR_close_field to end a field. Return -1 on failure, 0 on success.
 static int
 AK_DR_process_char(AK_DelimitedReader *dr, AK_CodePointGrid *cpg, Py_UCS4 c)
@@ -2594,9 +6453,7 @@ AK_DR_process_char(AK_DelimitedReader *dr, AK_CodePointGrid *cpg, Py_UCS4 c)
             dr->state = IN_FIELD;
         }
         else { // illegal
-            PyErr_Format(PyExc_RuntimeError, "'%c' expected after '%c'",
-                    dialect->delimiter, dialect->quotechar);
-            return -1;
+            return AK_DR_error(dr, DRE_QUOTE_IN_QUOTED_FIELD);
         }
         break;
     case EAT_CRNL:
@@ -2604,29 +6461,234 @@ AK_DR_process_char(AK_DelimitedReader *dr, AK_CodePointGrid *cpg, Py_UCS4 c)
         else if (c == '\0')
             dr->state = START_RECORD;
         else {
-            PyErr_Format(PyExc_RuntimeError,
-                    "new-line character seen in unquoted field - do you need to open the file in universal-newline mode?");
-            return -1;
+            return AK_DR_error(dr, DRE_NEWLINE_IN_FIELD);
+        }
+        break;
+    }
+    return 0;
+}
+
+// Called once at the start of processing each line in AK_DR_ProcessRecord. This cannot error.
+static void
+AK_DR_line_reset(AK_DelimitedReader *dr)
+{
+    dr->field_len = 0;
+    dr->state = START_RECORD;
+    dr->field_number = 0;
+    dr->field_keep = true;
+    dr->field_select_number = -1;
+}
+
+// Decode a UTF-8 multi-byte sequence starting at `*p`, where `**p` is known to be a non-ASCII byte; advance `*p` past the sequence. Returns the code point, or -1 if the sequence is invalid or truncated by `end`. Overlong encodings, surrogates, and values past U+10FFFF are rejected, as with CPython's strict decoder. Does not set an exception.
+static inline npy_int32
+AK_UTF8_decode(const unsigned char **p, const unsigned char *end)
+{
+    const unsigned char *s = *p;
+    npy_int32 c = *s;
+    npy_int32 min;
+    Py_ssize_t count; // number of continuation bytes
+
+    if (c < 0xC2) return -1; // continuation byte or overlong two-byte lead
+    else if (c < 0xE0) {
+        c &= 0x1F;
+        count = 1;
+        min = 0x80;
+    }
+    else if (c < 0xF0) {
+        c &= 0x0F;
+        count = 2;
+        min = 0x800;
+    }
+    else if (c < 0xF5) {
+        c &= 0x07;
+        count = 3;
+        min = 0x10000;
+    }
+    else return -1;
+
+    if (end - s <= count) return -1;
+    for (Py_ssize_t i = 1; i <= count; ++i) {
+        if ((s[i] & 0xC0) != 0x80) return -1;
+        c = (c << 6) | (s[i] & 0x3F);
+    }
+    if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) return -1;
+    *p = s + count + 1;
+    return c;
+}
+
+// Returns true if the line can be split with AK_DR_process_split.
+static inline bool
+AK_DR_split_line(AK_DelimitedReader *dr, const Py_UCS1 *p, const Py_UCS1 *end)
+{
+    if (!dr->split || p == end || *p == '\n' || *p == '\r' || *p == '\0') return false;
+    for (Py_ssize_t i = 0; i < dr->split_checks_count; ++i) {
+        if (memchr(p, dr->split_checks[i], end - p)) return false;
+    }
+    return true;
+}
+
+// Given a line (or the start of a multi-line record) without quote or escape characters, split fields on the delimiter, appending each field in bulk. Stops after the first line terminator, leaving the state machine to process any further characters. `*pp` is advanced past the characters processed. Returns 0 on success, -1 on error.
+static int
+AK_DR_process_split(AK_DelimitedReader *dr,
+        AK_CodePointGrid *cpg,
+        const Py_UCS1 **pp,
+        const Py_UCS1 *end,
+        bool utf8)
+{
+    const Py_UCS1 *p = *pp;
+    const Py_UCS1 *run_end;
+    Py_UCS4 delimiter = dr->dialect->delimiter;
+    npy_int32 c;
+
+    dr->state = START_FIELD;
+    while (p < end) {
+        run_end = AK_DR_scan_run(p, end, dr->split_stops);
+        if (run_end > p) {
+            if (AK_DR_add_chars(dr, cpg, p, run_end - p)) return -1;
+            dr->state = IN_FIELD;
+            p = run_end;
+            if (p == end) break;
+        }
+        if (AK_LIKELY(*p < 0x80) || !utf8) {
+            c = *p++;
+        }
+        else if ((c = AK_UTF8_decode(&p, end)) < 0) {
+            return -2; // let the caller record the decode error
+        }
+        if ((Py_UCS4)c == delimiter) {
+            if (AK_DR_close_field(dr, cpg)) return -1;
+            dr->state = START_FIELD;
+        }
+        else if (c == '\n' || c == '\r' || c == '\0') {
+            if (AK_DR_process_char(dr, cpg, (Py_UCS4)c)) return -1;
+            break;
+        }
+        else {
+            if (AK_DR_add_char(dr, cpg, (Py_UCS4)c)) return -1;
+            dr->state = IN_FIELD;
+        }
+    }
+    *pp = p;
+    return 0;
+}
+
+// Process a line of 1-byte characters, calling AK_DR_process_char on each code point. If `utf8`, the bytes are decoded as UTF-8; otherwise, each byte is a Latin-1 code point. Within unquoted or quoted fields, runs of ordinary ASCII characters are found with AK_DR_scan_run and appended in bulk, bypassing the state machine. Returns 0 on success, -1 on error.
+static int
+AK_DR_process_bytes(AK_DelimitedReader *dr,
+        AK_CodePointGrid *cpg,
+        const char *line,
+        const char *line_end,
+        bool utf8)
+{
+    const Py_UCS1 *p = (const Py_UCS1*)line;
+    const Py_UCS1 *end = (const Py_UCS1*)line_end;
+    const Py_UCS1 *run_end;
+    npy_int32 c;
+
+    if (dr->state == START_RECORD && AK_DR_split_line(dr, p, end)) {
+        switch (AK_DR_process_split(dr, cpg, &p, end, utf8)) {
+            case -1:
+                return -1;
+            case -2:
+                dr->error_line = line;
+                dr->error_line_end = line_end;
+                return AK_DR_error(dr, DRE_DECODE);
+        }
+    }
+    while (p < end) {
+        if (dr->state == IN_FIELD || dr->state == IN_QUOTED_FIELD) {
+            run_end = AK_DR_scan_run(p,
+                    end,
+                    dr->state == IN_FIELD ? dr->field_stops : dr->quoted_stops);
+            if (run_end > p) {
+                if (AK_DR_add_chars(dr, cpg, p, run_end - p)) return -1;
+                p = run_end;
+                if (p == end) break;
+            }
+        }
+        if (AK_LIKELY(*p < 0x80) || !utf8) {
+            c = *p++;
+        }
+        else if ((c = AK_UTF8_decode(&p, end)) < 0) {
+            dr->error_line = line;
+            dr->error_line_end = line_end;
+            return AK_DR_error(dr, DRE_DECODE);
+        }
+        if (AK_DR_process_char(dr, cpg, (Py_UCS4)c)) return -1;
+    }
+    return 0;
+}
+
+// Called when no further lines are available from the input. If the final record was not terminated, close the open field. Returns 0 on success, -1 on error.
+static inline int
+AK_DR_input_end(AK_DelimitedReader *dr, AK_CodePointGrid *cpg)
+{
+    // if parser is in an unexptected state
+    if ((dr->field_len != 0) || (dr->state == IN_QUOTED_FIELD)) {
+        if (dr->dialect->strict) {
+            return AK_DR_error(dr, DRE_END_OF_DATA);
         }
-        break;
+        // try to close the field, propagate error
+        if (AK_DR_close_field(dr, cpg)) return -1;
     }
     return 0;
 }
 
-// Called once at the start of processing each line in AK_DR_ProcessRecord. This cannot error.
-static void
-AK_DR_line_reset(AK_DelimitedReader *dr)
+// With a row_filter, the fields of each record are tokenized onto the stage; if the record passes, its fields are appended to `cpg` as if tokenized directly, applying `field_select`; otherwise, the record is not counted. The stage is then cleared. Returns 0 on success, -1 on failure.
+static int
+AK_DR_stage_commit(AK_DelimitedReader *dr,
+        AK_CodePointGrid *cpg,
+        AK_LineSelect *field_select)
 {
-    dr->field_len = 0;
-    dr->state = START_RECORD;
-    dr->field_number = 0;
+    dr->axis_pos = dr->axis == 0 ? &dr->record_number : &dr->field_number;
+    AK_CodePointLine *stage = dr->stage->lines[0];
+    Py_ssize_t count = stage->offsets_count;
+    if (count == 0) return 0;
+
+    if (AK_RF_keep(dr->row_filter, stage)) {
+        int kind = stage->kind;
+        const Py_UCS1 *p = stage->buffer;
+        for (Py_ssize_t k = 0; k < count; ++k) {
+            Py_ssize_t len = AK_CPL_field_len(stage, k);
+            Py_ssize_t line = dr->axis == 0 ? dr->record_number : k;
+            if (field_select != NULL) {
+                int keep = AK_LS_field_keep(field_select, k);
+                if (keep < 0) return AK_DR_error(dr, DRE_MEMORY);
+                if (!keep) {
+                    p += len * kind;
+                    continue;
+                }
+            }
+            if (kind == PyUnicode_1BYTE_KIND) {
+                if (len > 0 && AK_CPG_AppendPointsAtLine(cpg, line, 0, p, len)) {
+                    return AK_DR_error(dr, DRE_MEMORY);
+                }
+            }
+            else {
+                for (Py_ssize_t i = 0; i < len; ++i) {
+                    if (AK_CPG_AppendPointAtLine(cpg, line, i, PyUnicode_READ(kind, p, i))) {
+                        return AK_DR_error(dr, DRE_MEMORY);
+                    }
+                }
+            }
+            if (AK_CPG_AppendOffsetAtLine(cpg, line, len)) return AK_DR_error(dr, DRE_MEMORY);
+            p += len * kind;
+        }
+    }
+    else {
+        --dr->record_number;
+    }
+    if (AK_CPL_Reset(stage, false, 0, 0)) return AK_DR_error(dr, DRE_MEMORY);
+    return 0;
 }
 
-// Using AK_DelimitedReader's state, process one record (via next(input_iter)); call AK_DR_process_char on each char in that line, loading individual fields into AK_CodePointGrid. Returns 1 when there are more lines to process, 0 when there are no lines to process, and -1 for error.
+static int AK_DR_skip_records(AK_DelimitedReader *dr);
+
+// Using AK_DelimitedReader's state, process one record (via next(input_iter), or by reading the next line from input_view); call AK_DR_process_char on each char in that line, loading individual fields into AK_CodePointGrid. Returns 1 when there are more lines to process, 0 when there are no lines to process, and -1 for error.
 static int
 AK_DR_ProcessRecord(AK_DelimitedReader *dr,
         AK_CodePointGrid *cpg,
-        PyObject *line_select
+        AK_LineSelect *line_select
         )
 {
     Py_ssize_t linelen;
@@ -2634,25 +6696,66 @@ AK_DR_ProcessRecord(AK_DelimitedReader *dr,
     const void *data;
     PyObject *record;
 
+    if (AK_UNLIKELY(dr->skiprows > 0) && AK_DR_skip_records(dr)) return -1;
+    // once nrows records are loaded, no further input is read
+    if (dr->nrows_remaining == 0) return 0;
+    Py_ssize_t record_number = dr->record_number;
+
+    // a record might span multiple lines if a quoted field contains a newline; only the first line increments record counts
+    bool record_start = true;
+
+    // with axis 1, fields not selected are skipped while tokenizing
+    AK_LineSelect *field_select = (dr->axis == 1 && line_select != NULL
+            && !AK_LS_inactive(line_select)) ? line_select : NULL;
+    // with a row_filter, all fields are tokenized onto the stage, and are only added to the destination CPG if the record passes
+    AK_CodePointGrid *target = cpg;
+    if (dr->row_filter != NULL) {
+        cpg = dr->stage;
+        dr->axis_pos = &dr->stage_line;
+        dr->field_select = NULL;
+    }
+    else {
+        dr->field_select = field_select;
+    }
     AK_DR_line_reset(dr);
     do {
+        if (dr->input_view.obj != NULL || dr->stream != NULL) {
+            // read bytes directly from the buffer or stream
+            const char *line;
+            const char *line_end;
+            int found = AK_DR_next_line(dr, &line, &line_end);
+            if (found < 0) return -1;
+            if (found == 0) {
+                if (AK_DR_input_end(dr, cpg)) return -1;
+                if (cpg != target) return AK_DR_stage_commit(dr, target, field_select) ? -1 : 0;
+                return 0;
+            }
+            if (record_start) {
+                ++dr->record_iter_number;
+                switch (AK_line_select_keep(line_select,
+                        0 == dr->axis,
+                        dr->record_iter_number)) {
+                    case -1 :
+                        return -1;
+                    case 0:
+                        return 1; // skip, process more records
+                }
+                ++dr->record_number;
+                record_start = false;
+            }
+            if (AK_DR_process_bytes(dr, cpg, line, line_end, true)) return -1;
+            // force signaling we are at the end of a line
+            if (AK_DR_process_char(dr, cpg, '\0')) return -1;
+            continue;
+        }
         // get a string, representing one record, to parse
         record = PyIter_Next(dr->input_iter);
         if (record == NULL) {
             if (PyErr_Occurred()) return -1;
-            // if parser is in an unexptected state
-            if ((dr->field_len != 0) || (dr->state == IN_QUOTED_FIELD)) {
-                if (dr->dialect->strict) {
-                    PyErr_SetString(PyExc_RuntimeError, "unexpected end of data");
-                    return -1;
-                }
-                // try to close the field, propagate error
-                if (AK_DR_close_field(dr, cpg)) return -1;
-            }
+            if (AK_DR_input_end(dr, cpg)) return -1;
+            if (cpg != target) return AK_DR_stage_commit(dr, target, field_select) ? -1 : 0;
             return 0; // end of input, not an error
         }
-        ++dr->record_iter_number;
-
         if (!PyUnicode_Check(record)) {
             PyErr_Format(PyExc_RuntimeError,
                     "iterator should return strings, not %.200s "
@@ -2667,18 +6770,22 @@ AK_DR_ProcessRecord(AK_DelimitedReader *dr,
             return -1;
         }
 
-        switch (AK_line_select_keep(line_select,
-                0 == dr->axis,
-                dr->record_iter_number)) {
-            case -1 :
-                Py_DECREF(record);
-                return -1;
-            case 0:
-                Py_DECREF(record);
-                return 1; // skip, process more records
+        if (record_start) {
+            ++dr->record_iter_number;
+            switch (AK_line_select_keep(line_select,
+                    0 == dr->axis,
+                    dr->record_iter_number)) {
+                case -1 :
+                    Py_DECREF(record);
+                    return -1;
+                case 0:
+                    Py_DECREF(record);
+                    return 1; // skip, process more records
+            }
+            // NOTE: record_number should reflect the processed line count, and exlude any skipped lines. The value is initialized to -1 such the first line is number 0
+            ++dr->record_number;
+            record_start = false;
         }
-        // NOTE: record_number should reflect the processed line count, and exlude any skipped lines. The value is initialized to -1 such the first line is number 0
-        ++dr->record_number;
         // AK_DEBUG_MSG_OBJ("processing line", PyLong_FromLong(dr->record_number));
 
         kind = PyUnicode_KIND(record);
@@ -2688,13 +6795,10 @@ AK_DR_ProcessRecord(AK_DelimitedReader *dr,
         // NOTE: we used to check that the read character was not \0; this seems rare enough to not be necessary to handle explicit, as AK_DR_process_char will treat it as an end of record
         switch (kind) {
             case PyUnicode_1BYTE_KIND: {
-                Py_UCS1* uc = (Py_UCS1*)data;
-                Py_UCS1* uc_end = uc + linelen;
-                while (uc < uc_end) {
-                    if (AK_DR_process_char(dr, cpg, *uc++)) {
-                        Py_DECREF(record);
-                        return -1;
-                    }
+                const char* uc = (const char*)data;
+                if (AK_DR_process_bytes(dr, cpg, uc, uc + linelen, false)) {
+                    Py_DECREF(record);
+                    return -1;
                 }
                 break;
             }
@@ -2726,6 +6830,10 @@ AK_DR_ProcessRecord(AK_DelimitedReader *dr,
         if (AK_DR_process_char(dr, cpg, '\0')) return -1;
 
     } while (dr->state != START_RECORD);
+    // an empty line closes no fields and is not counted as a record; otherwise, with axis 0, the next record would leave an uninitialized line in the CPG
+    if (dr->field_number == 0) --dr->record_number;
+    if (cpg != target && AK_DR_stage_commit(dr, target, field_select)) return -1;
+    if (dr->nrows_remaining > 0 && dr->record_number > record_number) --dr->nrows_remaining;
     return 1; // more lines to process
 }
 
@@ -2736,10 +6844,55 @@ AK_DR_Free(AK_DelimitedReader *dr)
         AK_Dialect_Free(dr->dialect);
     }
     Py_XDECREF(dr->input_iter); // might already be NULL
+    if (dr->input_view.obj != NULL) {
+        PyBuffer_Release(&dr->input_view);
+    }
+    if (dr->stream) {
+        AK_DR_stream_free(dr->stream);
+    }
+    if (dr->row_filter) {
+        AK_RF_Free(dr->row_filter);
+    }
+    if (dr->stage) {
+        AK_CPG_Free(dr->stage);
+    }
     PyMem_Free(dr);
 }
 
-// The arguments to this constructor are validated before this function is valled. Returns NULL on error.
+// Return a new CPG of one line, without type parsing, on which the fields of a record are staged before testing with a row_filter. Returns NULL on error.
+static AK_CodePointGrid*
+AK_DR_stage_new(Py_UCS4 tsep, Py_UCS4 decc)
+{
+    AK_CodePointGrid *stage = AK_CPG_New(NULL, tsep, decc);
+    if (stage == NULL) return NULL;
+    stage->lines[0] = AK_CPL_New(false,
+            tsep,
+            decc,
+            AK_CPL_BUFFER_CAPACITY_MIN,
+            AK_CPL_OFFSETS_CAPACITY_MIN);
+    if (stage->lines[0] == NULL) {
+        AK_CPG_Free(stage);
+        return (AK_CodePointGrid*)PyErr_NoMemory();
+    }
+    stage->lines_count = 1;
+    stage->lines_allocated = 1;
+    return stage;
+}
+
+// Set a row_filter on an AK_DelimitedReader, given as a (column, test) tuple, a list of such tuples, or None. Returns 0 on success, -1 on error.
+static int
+AK_DR_SetRowFilter(AK_DelimitedReader *dr,
+        PyObject *row_filter,
+        Py_UCS4 tsep,
+        Py_UCS4 decc)
+{
+    dr->row_filter = AK_RF_New(row_filter, tsep, decc);
+    if (dr->row_filter == NULL) return PyErr_Occurred() ? -1 : 0;
+    dr->stage = AK_DR_stage_new(tsep, decc);
+    return dr->stage == NULL ? -1 : 0;
+}
+
+// The arguments to this constructor are validated before this function is valled. If `iterable` exports the buffer protocol (i.e., bytes, bytearray, memoryview, or mmap.mmap), its bytes are read directly as UTF-8; if `iterable` is a binary file object with a `readinto` method, its bytes are read as UTF-8 in blocks; otherwise `iterable` must be an iterable of strings. Returns NULL on error.
 static AK_DelimitedReader*
 AK_DR_New(PyObject *iterable,
         int axis,
@@ -2768,26 +6921,646 @@ AK_DR_New(PyObject *iterable,
     dr->record_number = -1;
     dr->record_iter_number = -1;
     dr->dialect = NULL; // init in case input_iter fails to init
+    dr->input_iter = NULL;
+    dr->input_view.obj = NULL;
+    dr->stream = NULL;
+    dr->input_pos = NULL;
+    dr->input_end = NULL;
+    dr->defer_error = false;
+    dr->error = DRE_NONE;
+    dr->skiprows = 0;
+    dr->nrows_remaining = -1;
+    dr->row_filter = NULL;
+    dr->stage = NULL;
+    dr->stage_line = 0;
+
+    // NOTE: arrays export the buffer protocol but are iterables of elements
+    if (PyObject_CheckBuffer(iterable) && !PyArray_Check(iterable)) {
+        if (PyObject_GetBuffer(iterable, &dr->input_view, PyBUF_SIMPLE)) {
+            dr->input_view.obj = NULL; // not set on failure
+            AK_DR_Free(dr);
+            return NULL;
+        }
+        dr->input_pos = (const char*)dr->input_view.buf;
+        dr->input_end = dr->input_pos + dr->input_view.len;
+    }
+    else if (PyObject_HasAttrString(iterable, "readinto")) {
+        PyObject *readinto = PyObject_GetAttrString(iterable, "readinto");
+        if (readinto == NULL) {
+            AK_DR_Free(dr);
+            return NULL;
+        }
+        dr->stream = AK_DR_stream_new(readinto);
+        Py_DECREF(readinto);
+        if (dr->stream == NULL) {
+            AK_DR_Free(dr);
+            return NULL;
+        }
+        // the first block is read on the first refill
+        dr->input_pos = dr->stream->buffers[0];
+        dr->input_end = dr->input_pos;
+    }
+    else {
+        dr->input_iter = PyObject_GetIter(iterable); // new ref, decref in free
+        if (dr->input_iter == NULL) {
+            AK_DR_Free(dr);
+            return NULL;
+        }
+    }
 
-    dr->input_iter = PyObject_GetIter(iterable); // new ref, decref in free
-    if (dr->input_iter == NULL) {
+    dr->dialect = AK_Dialect_New(
+            delimiter,
+            doublequote,
+            escapechar,
+            quotechar,
+            quoting,
+            skipinitialspace,
+            strict);
+    if (dr->dialect == NULL) {
         AK_DR_Free(dr);
         return NULL;
     }
-
-    dr->dialect = AK_Dialect_New(
-            delimiter,
-            doublequote,
-            escapechar,
-            quotechar,
-            quoting,
-            skipinitialspace,
-            strict);
-    if (dr->dialect == NULL) {
-        AK_DR_Free(dr);
-        return NULL;
+    AK_Dialect *dialect = dr->dialect;
+    Py_UCS4 quote = dialect->quoting == QUOTE_NONE ? 0 : dialect->quotechar;
+    // non-ASCII characters always end a run, so only ASCII dialect characters are needed
+    Py_UCS4 field_stops[AK_DR_STOPS] = {
+            dialect->delimiter, dialect->escapechar, '\n', '\r', '\0'};
+    Py_UCS4 quoted_stops[AK_DR_STOPS] = {
+            quote, dialect->escapechar, '\0', '\0', '\0'};
+    for (int i = 0; i < AK_DR_STOPS; ++i) {
+        dr->field_stops[i] = field_stops[i] < 0x80 ? (Py_UCS1)field_stops[i] : 0;
+        dr->quoted_stops[i] = quoted_stops[i] < 0x80 ? (Py_UCS1)quoted_stops[i] : 0;
+        dr->split_stops[i] = i == 1 ? 0 : dr->field_stops[i]; // no escapechar
+    }
+    // quote and escape characters can only be found with memchr if ASCII
+    dr->split = !dialect->skipinitialspace
+            && dialect->delimiter != '\n'
+            && dialect->delimiter != '\r'
+            && quote < 0x80
+            && dialect->escapechar < 0x80;
+    dr->split_checks_count = 0;
+    if (quote) dr->split_checks[dr->split_checks_count++] = (Py_UCS1)quote;
+    if (dialect->escapechar) {
+        dr->split_checks[dr->split_checks_count++] = (Py_UCS1)dialect->escapechar;
+    }
+    return dr;
+}
+
+//------------------------------------------------------------------------------
+// AK_DelimitedReader: threaded tokenizing
+
+// The minimum number of bytes given to each thread.
+# define AK_DR_THREAD_CHUNK_MIN 65536
+
+// Given a state and a character, return the next state, following the transitions of AK_DR_process_char without storing characters. Errors are not detected, as they will be raised when the record is tokenized. Cannot error.
+static inline AK_DelimitedReaderState
+AK_Dialect_scan_char(const AK_Dialect *dialect,
+        AK_DelimitedReaderState state,
+        Py_UCS4 c)
+{
+    switch (state) {
+    case START_RECORD:
+        if (c == '\0')
+            break;
+        else if (c == '\n' || c == '\r') {
+            state = EAT_CRNL;
+            break;
+        }
+        state = START_FIELD;
+        // fallthru
+    case START_FIELD:
+        if (c == '\n' || c == '\r' || c == '\0') {
+            state = (c == '\0' ? START_RECORD : EAT_CRNL);
+        }
+        else if (c == dialect->quotechar && dialect->quoting != QUOTE_NONE) {
+            state = IN_QUOTED_FIELD;
+        }
+        else if (c == dialect->escapechar) {
+            state = ESCAPED_CHAR;
+        }
+        else if (c == ' ' && dialect->skipinitialspace);
+        else if (c == dialect->delimiter);
+        else {
+            state = IN_FIELD;
+        }
+        break;
+    case ESCAPED_CHAR:
+        state = (c == '\n' || c == '\r') ? AFTER_ESCAPED_CRNL : IN_FIELD;
+        break;
+    case AFTER_ESCAPED_CRNL:
+        if (c == '\0') break;
+        // fallthru
+    case IN_FIELD:
+        if (c == '\n' || c == '\r' || c == '\0') {
+            state = (c == '\0' ? START_RECORD : EAT_CRNL);
+        }
+        else if (c == dialect->escapechar) {
+            state = ESCAPED_CHAR;
+        }
+        else if (c == dialect->delimiter) {
+            state = START_FIELD;
+        }
+        break;
+    case IN_QUOTED_FIELD:
+        if (c == '\0');
+        else if (c == dialect->escapechar) {
+            state = ESCAPE_IN_QUOTED_FIELD;
+        }
+        else if (c == dialect->quotechar && dialect->quoting != QUOTE_NONE) {
+            state = (dialect->doublequote ? QUOTE_IN_QUOTED_FIELD : IN_FIELD);
+        }
+        break;
+    case ESCAPE_IN_QUOTED_FIELD:
+        state = IN_QUOTED_FIELD;
+        break;
+    case QUOTE_IN_QUOTED_FIELD:
+        if (dialect->quoting != QUOTE_NONE && c == dialect->quotechar) {
+            state = IN_QUOTED_FIELD;
+        }
+        else if (c == dialect->delimiter) {
+            state = START_FIELD;
+        }
+        else if (c == '\n' || c == '\r' || c == '\0') {
+            state = (c == '\0' ? START_RECORD : EAT_CRNL);
+        }
+        else {
+            state = IN_FIELD;
+        }
+        break;
+    case EAT_CRNL:
+        if (c == '\0') state = START_RECORD;
+        break;
+    }
+    return state;
+}
+
+// Given `p`, the start of a record in UTF-8 encoded bytes, return the start of the first record that begins after `target`, or `end` if there is none. As line breaks within quoted or escaped fields do not end a record, records are found by scanning all characters from `p`. As the dialect's characters must be ASCII, bytes of multi-byte sequences can be scanned as any other character. Cannot error.
+static const char*
+AK_Dialect_next_record(const AK_Dialect *dialect,
+        const char *p,
+        const char *target,
+        const char *end)
+{
+    if (target < p) target = p;
+    if (dialect->quoting == QUOTE_NONE && dialect->escapechar == 0) {
+        // every line ends a record
+        const char *nl = memchr(target, '\n', end - target);
+        return nl == NULL ? end : nl + 1;
+    }
+    AK_DelimitedReaderState state = START_RECORD;
+    Py_UCS4 c;
+    while (p < end) {
+        c = (unsigned char)*p++;
+        state = AK_Dialect_scan_char(dialect, state, c);
+        if (c == '\n') {
+            // as in AK_DR_ProcessRecord, each line is followed by a '\0'
+            state = AK_Dialect_scan_char(dialect, state, '\0');
+            if (state == START_RECORD && p > target) return p;
+        }
+    }
+    return end;
+}
+
+// The states a line break can leave, in the order scanned by AK_Dialect_scan: the start of a record, within a quoted field, or after an escaped line break.
+static const AK_DelimitedReaderState AK_Dialect_scan_states[] = {
+        START_RECORD, IN_QUOTED_FIELD, AFTER_ESCAPED_CRNL};
+
+// A range of UTF-8 encoded bytes that starts at the start of the input or after a line break, scanned from more than one state.
+typedef struct AK_DR_Scan {
+    const char *start;
+    const char *end;
+    AK_DelimitedReaderState states[3]; // the states to scan from, set to the states at `end`
+    const char *records[3]; // for each state, the start of the first record at or after `start`, or NULL if none before `end`
+} AK_DR_Scan;
+
+// Scan the range of `scan` once for each of the first `count` states of `scan->states`, following all in one pass over the bytes. As with AK_Dialect_next_record, the dialect's characters must be ASCII. Cannot error.
+static void
+AK_Dialect_scan(const AK_Dialect *dialect, AK_DR_Scan *scan, int count)
+{
+    AK_DelimitedReaderState *states = scan->states;
+    for (int j = 0; j < count; ++j) {
+        scan->records[j] = states[j] == START_RECORD ? scan->start : NULL;
+    }
+    const char *p = scan->start;
+    Py_UCS4 c;
+    while (p < scan->end) {
+        c = (unsigned char)*p++;
+        for (int j = 0; j < count; ++j) {
+            states[j] = AK_Dialect_scan_char(dialect, states[j], c);
+            if (c == '\n') {
+                states[j] = AK_Dialect_scan_char(dialect, states[j], '\0');
+                if (states[j] == START_RECORD && scan->records[j] == NULL) {
+                    scan->records[j] = p;
+                }
+            }
+        }
+    }
+}
+
+// Return the number of records in UTF-8 encoded bytes from `p` to `end`, for sizing lines before tokenizing. Line breaks are found with memchr; a line break ends a record only if preceded by an even number of quote characters. As quote characters within unquoted fields and escaped line breaks are not interpreted as when tokenizing, the count might differ from the records tokenized. Cannot error.
+static Py_ssize_t
+AK_Dialect_count_records(const AK_Dialect *dialect, const char *p, const char *end)
+{
+    char quote = (dialect->quoting != QUOTE_NONE && dialect->quotechar < 0x80)
+            ? (char)dialect->quotechar : '\0';
+    const char *q = quote ? memchr(p, quote, end - p) : NULL;
+    bool quoted = false;
+    Py_ssize_t count = 0;
+    if (q == NULL) {
+        // without quotes, count line breaks in blocks of a loop the compiler can vectorize
+        const unsigned char *u = (const unsigned char*)p;
+        const unsigned char *u_end = (const unsigned char*)end;
+        while (u < u_end) {
+            const unsigned char *block_end = u_end - u > 255 ? u + 255 : u_end;
+            unsigned char block = 0;
+            for (; u < block_end; ++u) block += *u == '\n';
+            count += block;
+        }
+        return count + (end > p && end[-1] != '\n');
+    }
+    const char *nl;
+    while (p < end && (nl = memchr(p, '\n', end - p)) != NULL) {
+        for (; q != NULL && q < nl; q = memchr(q + 1, quote, end - q - 1)) {
+            quoted = !quoted;
+        }
+        if (!quoted) ++count;
+        p = nl + 1;
+    }
+    // a final record without a line break
+    if (p < end) ++count;
+    return count;
+}
+
+// Skip the records remaining in `skiprows` from the start of the input, finding the end of each record without tokenizing it. Skipped records are not given to line_select, and do not count in its positions. Returns 0 on success, -1 on error.
+static int
+AK_DR_skip_records(AK_DelimitedReader *dr)
+{
+    const AK_Dialect *dialect = dr->dialect;
+    // without quoting or escaping, every line is a record
+    bool lines = dialect->quoting == QUOTE_NONE && dialect->escapechar == 0;
+
+    for (; dr->skiprows > 0; --dr->skiprows) {
+        if (dr->input_view.obj != NULL) {
+            if (dr->input_pos >= dr->input_end) break;
+            dr->input_pos = AK_Dialect_next_record(dialect,
+                    dr->input_pos,
+                    dr->input_pos,
+                    dr->input_end);
+            continue;
+        }
+        AK_DelimitedReaderState state = START_RECORD;
+        if (dr->stream != NULL) {
+            const char *line;
+            const char *line_end;
+            do {
+                int found = AK_DR_next_line(dr, &line, &line_end);
+                if (found < 0) return -1;
+                if (found == 0) {
+                    dr->skiprows = 0;
+                    return 0;
+                }
+                if (lines) break;
+                for (; line < line_end; ++line) {
+                    state = AK_Dialect_scan_char(dialect, state, (unsigned char)*line);
+                }
+                state = AK_Dialect_scan_char(dialect, state, '\0');
+            } while (state != START_RECORD);
+            continue;
+        }
+        do {
+            PyObject *record = PyIter_Next(dr->input_iter);
+            if (record == NULL) {
+                if (PyErr_Occurred()) return -1;
+                dr->skiprows = 0;
+                return 0;
+            }
+            if (!PyUnicode_Check(record)) {
+                PyErr_Format(PyExc_RuntimeError,
+                        "iterator should return strings, not %.200s "
+                        "(the file should be opened in text mode)",
+                        Py_TYPE(record)->tp_name
+                        );
+                Py_DECREF(record);
+                return -1;
+            }
+            if (lines) {
+                Py_DECREF(record);
+                break;
+            }
+            if (PyUnicode_READY(record) == -1) {
+                Py_DECREF(record);
+                return -1;
+            }
+            int kind = PyUnicode_KIND(record);
+            const void *data = PyUnicode_DATA(record);
+            Py_ssize_t linelen = PyUnicode_GET_LENGTH(record);
+            for (Py_ssize_t i = 0; i < linelen; ++i) {
+                state = AK_Dialect_scan_char(dialect, state, PyUnicode_READ(kind, data, i));
+            }
+            Py_DECREF(record);
+            // as in AK_DR_ProcessRecord, each line is followed by a '\0'
+            state = AK_Dialect_scan_char(dialect, state, '\0');
+        } while (state != START_RECORD);
+    }
+    return 0;
+}
+
+// Process records until the input is exhausted or, if `limit` is non-negative, until `limit` records are loaded. With stream input, if no Python calls are needed while tokenizing, the GIL is released such that the next block is read while the current block is tokenized. Returns 0 if the input is exhausted, 1 if more records might remain, -1 on error.
+static int
+AK_DR_ProcessRecords(AK_DelimitedReader *dr,
+        AK_CodePointGrid *cpg,
+        AK_LineSelect *line_select,
+        Py_ssize_t limit)
+{
+    int status = 1;
+    if (dr->stream != NULL
+            && cpg->dtypes == NULL
+            && (line_select == NULL || line_select->callable == NULL)) {
+        bool defer_error = dr->defer_error;
+        dr->defer_error = true;
+        dr->stream->gil_released = true;
+        Py_BEGIN_ALLOW_THREADS
+        while ((limit < 0 || dr->record_number + 1 < limit)
+                && (status = AK_DR_ProcessRecord(dr, cpg, line_select)) == 1);
+        Py_END_ALLOW_THREADS
+        dr->stream->gil_released = false;
+        dr->defer_error = defer_error;
+        if (status == -1 && !defer_error) AK_DR_RaiseError(dr);
+        return status;
+    }
+    while ((limit < 0 || dr->record_number + 1 < limit)
+            && (status = AK_DR_ProcessRecord(dr, cpg, line_select)) == 1);
+    return status;
+}
+
+// Each chunk is a range of complete records tokenized into its own CPG by a copy of the AK_DelimitedReader.
+typedef struct AK_DR_Chunk {
+    AK_DelimitedReader dr;
+    AK_CodePointGrid *cpg;
+    int status;
+} AK_DR_Chunk;
+
+typedef struct AK_DR_Chunks {
+    AK_DR_Chunk *chunks;
+    Py_ssize_t count;
+    AK_CodePointGrid *cpg; // destination of stitched lines
+    AK_LineSelect *line_select; // NULL, or for axis 1, a line_select given as an array
+    bool failed; // set if stitching a line failed
+} AK_DR_Chunks;
+
+typedef struct AK_DR_Scans {
+    const AK_Dialect *dialect;
+    AK_DR_Scan *scans;
+    int states_count; // the number of AK_Dialect_scan_states speculated for ranges after the first
+} AK_DR_Scans;
+
+// Scan a range of input for chunk boundaries; the first range starts at a record, while later ranges are scanned from each state a line break can leave. Called without the GIL.
+static void
+AK_DR_chunk_scan(void *context, Py_ssize_t i)
+{
+    AK_DR_Scans *scans = (AK_DR_Scans*)context;
+    AK_DR_Scan *scan = scans->scans + i;
+    int count = i == 0 ? 1 : scans->states_count;
+    memcpy(scan->states, AK_Dialect_scan_states, sizeof(AK_DelimitedReaderState) * count);
+    AK_Dialect_scan(scans->dialect, scan, count);
+}
+
+// Tokenize all records in a chunk; called without the GIL.
+static void
+AK_DR_chunk_process(void *context, Py_ssize_t i)
+{
+    AK_DR_Chunks *chunks = (AK_DR_Chunks*)context;
+    AK_DR_Chunk *chunk = chunks->chunks + i;
+    int status;
+    while ((status = AK_DR_ProcessRecord(&chunk->dr, chunk->cpg, chunks->line_select)) == 1);
+    chunk->status = status;
+}
+
+// For axis 1, combine each chunk's CPL for column `i` into one CPL, in chunk order, and set it in the destination CPG. Chunk CPLs are freed as they are consumed; columns not selected have no CPLs and remain NULL. Called without the GIL; on memory failure, `failed` is set.
+static void
+AK_DR_chunk_stitch_line(void *context, Py_ssize_t i)
+{
+    AK_DR_Chunks *chunks = (AK_DR_Chunks*)context;
+    AK_CodePointLine *base = NULL;
+    AK_CodePointGrid *cpg;
+
+    for (Py_ssize_t k = 0; k < chunks->count; ++k) {
+        cpg = chunks->chunks[k].cpg;
+        // fewer fields in this chunk, or a column not selected
+        if (i >= cpg->lines_count || cpg->lines[i] == NULL) continue;
+        if (base == NULL) {
+            base = cpg->lines[i];
+        }
+        else if (AK_CPL_Extend(base, cpg->lines[i])) {
+            AK_CPL_Free(base);
+            base = NULL;
+            chunks->failed = true;
+            break;
+        }
+        else {
+            AK_CPL_Free(cpg->lines[i]);
+        }
+        cpg->lines[i] = NULL;
+    }
+    chunks->cpg->lines[i] = base;
+}
+
+// Move chunk lines into the destination CPG: for axis 0, lines are concatenated; for axis 1, lines are stitched together with AK_DR_chunk_stitch_line. Called without the GIL. Returns 0 on success, -1 on memory failure without setting an exception.
+static int
+AK_DR_chunks_stitch(AK_DR_Chunks *chunks, int axis, int threads)
+{
+    AK_CodePointGrid *cpg = chunks->cpg;
+    AK_CodePointGrid *chunk_cpg;
+    Py_ssize_t lines_count = 0;
+
+    for (Py_ssize_t k = 0; k < chunks->count; ++k) {
+        chunk_cpg = chunks->chunks[k].cpg;
+        if (axis == 0) {
+            lines_count += chunk_cpg->lines_count;
+        }
+        else if (chunk_cpg->lines_count > lines_count) {
+            lines_count = chunk_cpg->lines_count;
+        }
+    }
+    if (lines_count > cpg->lines_capacity) {
+        AK_CodePointLine **lines = PyMem_RawRealloc(cpg->lines,
+                sizeof(AK_CodePointLine*) * lines_count);
+        if (lines == NULL) return -1;
+        cpg->lines = lines;
+        cpg->lines_capacity = lines_count;
+    }
+    if (axis == 0) {
+        for (Py_ssize_t k = 0; k < chunks->count; ++k) {
+            chunk_cpg = chunks->chunks[k].cpg;
+            memcpy(cpg->lines + cpg->lines_count,
+                    chunk_cpg->lines,
+                    sizeof(AK_CodePointLine*) * chunk_cpg->lines_count);
+            cpg->lines_count += chunk_cpg->lines_count;
+            cpg->lines_allocated = cpg->lines_count;
+            chunk_cpg->lines_count = 0; // lines now owned by cpg
+            chunk_cpg->lines_allocated = 0;
+        }
+        return 0;
+    }
+    AK_ParallelFor(lines_count, threads, AK_DR_chunk_stitch_line, chunks);
+    cpg->lines_count = lines_count;
+    cpg->lines_allocated = lines_count;
+    return chunks->failed ? -1 : 0;
+}
+
+// Tokenize all remaining input of an AK_DelimitedReader reading from a buffer into `cpg`, using up to `threads` threads. The input is split into chunks of complete records; each chunk is tokenized into its own CPG on a thread without the GIL, and the resulting lines are then moved into `cpg`. As a line_select callable is not called, this can only be used without a line_select or for axis 1; with axis 1, a line_select given as an array skips fields not selected while tokenizing, and lines of dtypes resolved into an array are not type parsed. As a chunk's first record position is not known, with axis 0 (or with a dtypes callable, which is not called while tokenizing) all lines are type parsed. The dialect's characters must be ASCII. Returns 0 on success, -1 on error.
+static int
+AK_DR_ProcessThreaded(AK_DelimitedReader *dr,
+        AK_CodePointGrid *cpg,
+        AK_LineSelect *line_select,
+        int threads)
+{
+    if (AK_DR_skip_records(dr)) return -1;
+    const char *start = dr->input_pos;
+    const char *end = dr->input_end;
+
+    Py_ssize_t count = (end - start) / AK_DR_THREAD_CHUNK_MIN;
+    if (count > threads) count = threads;
+    if (count < 1) count = 1;
+
+    // zeroed, as chunks counted for cleanup might fail before their stage is assigned
+    AK_DR_Chunk *chunks = (AK_DR_Chunk*)PyMem_Calloc(count, sizeof(AK_DR_Chunk));
+    if (chunks == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    AK_DR_Scan *scans = (AK_DR_Scan*)PyMem_Malloc(sizeof(AK_DR_Scan) * count);
+    if (scans == NULL) {
+        PyMem_Free(chunks);
+        PyErr_NoMemory();
+        return -1;
+    }
+    const AK_Dialect *dialect = dr->dialect;
+    bool scan = dialect->quoting != QUOTE_NONE || dialect->escapechar != 0;
+    AK_DR_Scans scan_context = {dialect, scans, dialect->escapechar != 0 ? 3 : 2};
+    Py_ssize_t size = (end - start) / count;
+    const char *p = start;
+    const char *nl;
+    Py_ssize_t ranges = 0;
+    Py_ssize_t k = 0;
+
+    Py_BEGIN_ALLOW_THREADS
+    // Split the input into ranges that start after the first line break at or after each target. Without quoting or escaping, each range starts a record; otherwise, each range is scanned on a thread from every state a line break can leave, and the state found at the end of each range selects the scan of the next.
+    while (ranges < count && p < end) {
+        scans[ranges].start = p;
+        const char *target = start + size * (ranges + 1);
+        if (target < p) target = p;
+        nl = ranges == count - 1 ? NULL : memchr(target, '\n', end - target);
+        p = nl == NULL ? end : nl + 1;
+        scans[ranges++].end = p;
+    }
+    if (scan) {
+        AK_ParallelFor(ranges, threads, AK_DR_chunk_scan, &scan_context);
+    }
+    // chunks that would be empty or start at the end of the input are dropped
+    AK_DelimitedReaderState state = (scan && ranges > 0) ? scans[0].states[0] : START_RECORD;
+    chunks[0].dr.input_pos = start;
+    for (Py_ssize_t i = 1; i < ranges; ++i) {
+        AK_DR_Scan *range = scans + i;
+        const char *record = range->start;
+        if (scan) {
+            int j = 0;
+            while (j < scan_context.states_count && AK_Dialect_scan_states[j] != state) ++j;
+            if (j == scan_context.states_count) {
+                // only possible with a dialect character that is a line break; rescan from the state found
+                range->states[0] = state;
+                AK_Dialect_scan(dialect, range, 1);
+                j = 0;
+            }
+            record = range->records[j];
+            state = range->states[j];
+        }
+        if (record != NULL && record > chunks[k].dr.input_pos && record < end) {
+            chunks[k++].dr.input_end = record;
+            chunks[k].dr.input_pos = record;
+        }
+    }
+    if (ranges > 0) {
+        chunks[k++].dr.input_end = end;
+    }
+    count = k;
+    Py_END_ALLOW_THREADS
+    PyMem_Free(scans);
+
+    AK_DR_Chunks context = {chunks, 0, cpg, NULL, false};
+    if (dr->axis == 1 && line_select != NULL && line_select->callable == NULL) {
+        context.line_select = line_select;
+    }
+    int status = 0;
+    for (k = 0; k < count; ++k) {
+        AK_DR_Chunk *chunk = chunks + k;
+        chunk->cpg = AK_CPG_New(NULL, cpg->tsep, cpg->decc);
+        if (chunk->cpg == NULL) {
+            status = -1;
+            break;
+        }
+        chunk->cpg->na_values = cpg->na_values;
+        ++context.count;
+        // with axis 1, a line is a column at the same position in every chunk
+        if (dr->axis == 1 && AK_CPG_copy_dtypes(chunk->cpg, cpg)) {
+            status = -1;
+            break;
+        }
+        const char *input_pos = chunk->dr.input_pos;
+        const char *input_end = chunk->dr.input_end;
+        chunk->dr = *dr;
+        chunk->dr.input_pos = input_pos;
+        chunk->dr.input_end = input_end;
+        chunk->dr.record_number = -1;
+        chunk->dr.record_iter_number = -1;
+        chunk->dr.axis_pos = (dr->axis == 0
+                ? &chunk->dr.record_number
+                : &chunk->dr.field_number);
+        chunk->dr.defer_error = true;
+        chunk->dr.error = DRE_NONE;
+        chunk->status = 0;
+        if (dr->stage != NULL) {
+            // the row_filter is shared, but each chunk stages its own records
+            chunk->dr.stage = AK_DR_stage_new(cpg->tsep, cpg->decc);
+            if (chunk->dr.stage == NULL) {
+                status = -1;
+                break;
+            }
+        }
+    }
+    if (status == 0) {
+        Py_BEGIN_ALLOW_THREADS
+        AK_ParallelFor(count, threads, AK_DR_chunk_process, &context);
+        for (k = 0; k < count; ++k) {
+            if (chunks[k].status == -1) {
+                status = -1;
+                break;
+            }
+        }
+        if (status == 0 && AK_DR_chunks_stitch(&context, dr->axis, threads)) {
+            status = -1;
+            k = -1; // a memory error, not from a chunk
+        }
+        Py_END_ALLOW_THREADS
+        if (status == -1) {
+            // raise the error from the first failed chunk, as would be found tokenizing serially
+            if (k >= 0) {
+                AK_DR_RaiseError(&chunks[k].dr);
+            }
+            else {
+                PyErr_NoMemory();
+            }
+        }
     }
-    return dr;
+    for (k = 0; k < context.count; ++k) {
+        AK_CPG_Free(chunks[k].cpg);
+        if (dr->stage != NULL && chunks[k].dr.stage != NULL) {
+            AK_CPG_Free(chunks[k].dr.stage);
+        }
+    }
+    PyMem_Free(chunks);
+    dr->input_pos = end;
+    return status;
 }
 
 //------------------------------------------------------------------------------
@@ -2799,7 +7572,8 @@ AK_IterableStrToArray1D(
     PyObject *sequence,
     PyObject *dtype_specifier,
     Py_UCS4 tsep,
-    Py_UCS4 decc)
+    Py_UCS4 decc,
+    const AK_NAValues *na_values)
 {
     PyArray_Descr* dtype = NULL;
     // will set dtype_specifier to NULL for None, and propagate NULLs
@@ -2808,8 +7582,11 @@ AK_IterableStrToArray1D(
     // dtype only NULL from here
     bool type_parse = dtype == NULL;
 
-    AK_CodePointLine* cpl = AK_CPL_FromIterable(sequence, type_parse, tsep, decc);
-    if (cpl == NULL) return NULL;
+    AK_CodePointLine* cpl = AK_CPL_FromIterable(sequence, type_parse, tsep, decc, na_values);
+    if (cpl == NULL) {
+        Py_XDECREF(dtype);
+        return NULL;
+    }
 
     PyObject* array = AK_CPL_ToArray(cpl, dtype, tsep, decc);
     AK_CPL_Free(cpl);
@@ -2825,6 +7602,13 @@ static char *delimited_to_ararys_kwarg_names[] = {
     "axis",
     "dtypes",
     "line_select",
+    "row_filter",
+    "categorical",
+    "narrow_int",
+    "narrow_float",
+    "na_values",
+    "skiprows",
+    "nrows",
     "delimiter",
     "doublequote",
     "escapechar",
@@ -2834,6 +7618,8 @@ static char *delimited_to_ararys_kwarg_names[] = {
     "strict",
     "thousandschar",
     "decimalchar",
+    "threads",
+    "preallocate",
     NULL
 };
 
@@ -2845,6 +7631,13 @@ delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
     int axis = 0;
     PyObject *dtypes = NULL;
     PyObject *line_select = NULL;
+    PyObject *row_filter = NULL;
+    PyObject *categorical = NULL;
+    int narrow_int = 0;
+    int narrow_float = 0;
+    PyObject *na_values = NULL;
+    PyObject *skiprows = NULL;
+    PyObject *nrows = NULL;
     PyObject *delimiter = NULL;
     PyObject *doublequote = NULL;
     PyObject *escapechar = NULL;
@@ -2854,15 +7647,24 @@ delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
     PyObject *strict = NULL;
     PyObject *thousandschar = NULL;
     PyObject *decimalchar = NULL;
+    int threads = 1;
+    int preallocate = 0;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-            "O|$iOOOOOOOOOOO:delimited_to_arrays",
+            "O|$iOOOOppOOOOOOOOOOOOip:delimited_to_arrays",
             delimited_to_ararys_kwarg_names,
             &file_like,
             // kwarg only
             &axis,
             &dtypes,
             &line_select,
+            &row_filter,
+            &categorical,
+            &narrow_int,
+            &narrow_float,
+            &na_values,
+            &skiprows,
+            &nrows,
             &delimiter,
             &doublequote,
             &escapechar,
@@ -2871,20 +7673,35 @@ delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
             &skipinitialspace,
             &strict,
             &thousandschar,
-            &decimalchar))
+            &decimalchar,
+            &threads,
+            &preallocate))
         return NULL;
 
-    // normalize line_select to NULL or callable
-    if ((line_select == NULL) || (line_select == Py_None)) {
-        line_select = NULL;
+    if ((axis < 0) || (axis > 1)) {
+        PyErr_SetString(PyExc_ValueError, "Axis must be 0 or 1");
+        return NULL;
     }
-    else if (!PyCallable_Check(line_select)) {
-        PyErr_SetString(PyExc_TypeError, "line_select must be a callable or None");
+    if (threads < 1) {
+        PyErr_SetString(PyExc_ValueError, "threads must be greater than zero");
         return NULL;
     }
-
-    if ((axis < 0) || (axis > 1)) {
-        PyErr_SetString(PyExc_ValueError, "Axis must be 0 or 1");
+    Py_ssize_t skiprows_count;
+    if (AK_set_count("skiprows", &skiprows_count, skiprows, 0)) return NULL;
+    Py_ssize_t nrows_count;
+    if (AK_set_count("nrows", &nrows_count, nrows, -1)) return NULL;
+    AK_NAValues *na = AK_NA_New(na_values);
+    if (na == NULL && PyErr_Occurred()) return NULL;
+    AK_LineSelect ls;
+    if (AK_LS_Set(&ls, line_select)) {
+        AK_NA_Free(na);
+        return NULL;
+    }
+    AK_LineSelect cs;
+    AK_LineSelect *categorical_select;
+    if (AK_LS_SetCategorical(&cs, categorical, &categorical_select)) {
+        AK_LS_Clear(&ls);
+        AK_NA_Free(na);
         return NULL;
     }
     AK_DelimitedReader *dr = AK_DR_New(file_like,
@@ -2897,6 +7714,9 @@ delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
             skipinitialspace,
             strict);
     if (dr == NULL) { // can happen due to validation of dialect parameters
+        AK_LS_Clear(&ls);
+        AK_LS_Clear(&cs);
+        AK_NA_Free(na);
         return NULL;
     }
 
@@ -2907,6 +7727,9 @@ delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
             thousandschar,
             '\0')) {
         AK_DR_Free(dr);
+        AK_LS_Clear(&ls);
+        AK_LS_Clear(&cs);
+        AK_NA_Free(na);
         return NULL; // default is off (skips evaluation)
     }
     Py_UCS4 decc;
@@ -2916,45 +7739,518 @@ delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
             decimalchar,
             '.')) {
         AK_DR_Free(dr);
+        AK_LS_Clear(&ls);
+        AK_LS_Clear(&cs);
+        AK_NA_Free(na);
+        return NULL;
+    }
+    if (AK_DR_SetRowFilter(dr, row_filter, tsep, decc)) {
+        AK_DR_Free(dr);
+        AK_LS_Clear(&ls);
+        AK_LS_Clear(&cs);
+        AK_NA_Free(na);
         return NULL;
     }
+    dr->skiprows = skiprows_count;
+    dr->nrows_remaining = nrows_count;
 
-    // dtypes inc / dec ref bound within CPG life
+    // dtypes inc / dec ref bound within CPG life; sequences and dicts are resolved here
     AK_CodePointGrid* cpg = AK_CPG_New(dtypes, tsep, decc);
     if (cpg == NULL) { // error will be set
         AK_DR_Free(dr);
+        AK_LS_Clear(&ls);
+        AK_LS_Clear(&cs);
+        AK_NA_Free(na);
         return NULL;
     }
-    // Consume all lines from dr and load into cpg
-    int status;
-    while (true) {
-        status = AK_DR_ProcessRecord(dr, cpg, line_select);
-        if (status == 1) {
-            continue; // more lines to process
+    cpg->narrow_int = narrow_int;
+    cpg->narrow_float = narrow_float;
+    cpg->na_values = na;
+    // Consume all lines from dr and load into cpg. Threads are only used for buffer input where line_select is not needed while tokenizing, without nrows, and with ASCII dialect characters that can be found in UTF-8 bytes.
+    AK_Dialect *dialect = dr->dialect;
+    if (threads > 1
+            && dr->input_view.obj != NULL
+            && dr->nrows_remaining < 0
+            && (AK_LS_inactive(&ls) || axis == 1)
+            && dialect->delimiter < 0x80
+            && dialect->quotechar < 0x80
+            && dialect->escapechar < 0x80) {
+        if (AK_DR_ProcessThreaded(dr, cpg, &ls, threads)) {
+            AK_DR_Free(dr);
+            AK_CPG_Free(cpg);
+            AK_LS_Clear(&ls);
+            AK_LS_Clear(&cs);
+            AK_NA_Free(na);
+            return NULL;
         }
-        else if (status == 0) {
-            break;
+    }
+    else if (preallocate && dr->input_view.obj != NULL) {
+        // count records before tokenizing to size lines up front; as empty lines and skipped or filtered records are counted, this is an upper bound
+        Py_ssize_t records;
+        Py_BEGIN_ALLOW_THREADS
+        records = AK_Dialect_count_records(dialect, dr->input_pos, dr->input_end);
+        Py_END_ALLOW_THREADS
+        if (dr->nrows_remaining >= 0 && dr->nrows_remaining < records) {
+            records = dr->nrows_remaining;
         }
-        else if (status == -1) {
+        if (AK_CPG_presize(cpg, axis, records)) {
             AK_DR_Free(dr);
             AK_CPG_Free(cpg);
+            AK_LS_Clear(&ls);
+            AK_LS_Clear(&cs);
+            AK_NA_Free(na);
             return NULL;
         }
-        // NOTE: could use PyErr_CheckSignals() at some number of dr->record_number
+    }
+    if (AK_DR_ProcessRecords(dr, cpg, &ls, -1) == -1) {
+        AK_DR_Free(dr);
+        AK_CPG_Free(cpg);
+        AK_LS_Clear(&ls);
+        AK_LS_Clear(&cs);
+        AK_NA_Free(na);
+        return NULL;
     }
     AK_DR_Free(dr);
 
-    PyObject* arrays = AK_CPG_ToArrayList(cpg, axis, line_select, tsep, decc);
+    PyObject* arrays = AK_CPG_ToArrayList(cpg,
+            axis,
+            &ls,
+            categorical_select,
+            tsep,
+            decc,
+            threads);
     // NOTE: do not need to check if arrays is NULL as we will return NULL anyway
     AK_CPG_Free(cpg); // will free reference to dtypes
+    AK_LS_Clear(&ls);
+    AK_LS_Clear(&cs);
+    AK_NA_Free(na);
     return arrays; // could be NULL
 }
 
+//------------------------------------------------------------------------------
+// delimited_to_arrays iterator
+
+static PyTypeObject DelimitedArraysIterType;
+
+// Yields a list of arrays for every `chunk_records` records. The CPG, and its CPLs, are reused for each chunk.
+typedef struct DelimitedArraysIterObject {
+    PyObject_HEAD
+    AK_DelimitedReader *dr; // NULL once input is exhausted
+    AK_CodePointGrid *cpg;
+    AK_LineSelect line_select;
+    AK_LineSelect categorical;
+    AK_LineSelect *categorical_select; // NULL, or categorical
+    AK_NAValues *na_values; // NULL, or borrowed by the CPG
+    Py_ssize_t chunk_records;
+    Py_ssize_t records; // records yielded so far
+    int axis;
+    Py_UCS4 tsep;
+    Py_UCS4 decc;
+    int threads;
+    bool running; // set while a chunk is read and converted, as callables might call next()
+} DelimitedArraysIterObject;
+
+// The reader, CPG, and line selections can own callables and input objects that refer back to the iterator.
+static int
+DelimitedArraysIter_traverse(DelimitedArraysIterObject *self, visitproc visit, void *arg)
+{
+    if (self->dr) {
+        Py_VISIT(self->dr->input_iter);
+        Py_VISIT(self->dr->input_view.obj);
+        if (self->dr->stream) {
+            Py_VISIT(self->dr->stream->readinto);
+            Py_VISIT(self->dr->stream->error_type);
+            Py_VISIT(self->dr->stream->error_value);
+            Py_VISIT(self->dr->stream->error_tb);
+        }
+    }
+    if (self->cpg) {
+        Py_VISIT(self->cpg->dtypes);
+    }
+    Py_VISIT(self->line_select.callable);
+    Py_VISIT(self->categorical.callable);
+    return 0;
+}
+
+// As the reader owns the references to the input, it is freed, ending iteration.
+static int
+DelimitedArraysIter_clear(DelimitedArraysIterObject *self)
+{
+    if (self->dr) {
+        AK_DR_Free(self->dr);
+        self->dr = NULL;
+    }
+    if (self->cpg) {
+        Py_CLEAR(self->cpg->dtypes);
+    }
+    Py_CLEAR(self->line_select.callable);
+    Py_CLEAR(self->categorical.callable);
+    return 0;
+}
+
+static void
+DelimitedArraysIter_dealloc(DelimitedArraysIterObject *self) {
+    PyObject_GC_UnTrack(self);
+    if (self->dr) {
+        AK_DR_Free(self->dr);
+    }
+    if (self->cpg) {
+        AK_CPG_Free(self->cpg);
+    }
+    AK_LS_Clear(&self->line_select);
+    AK_LS_Clear(&self->categorical);
+    AK_NA_Free(self->na_values);
+    PyObject_GC_Del((PyObject*)self);
+}
+
+static PyObject*
+DelimitedArraysIter_iter(DelimitedArraysIterObject *self) {
+    Py_INCREF(self);
+    return (PyObject*)self;
+}
+
+// Read and convert the next chunk; only called when not running.
+static PyObject *
+DelimitedArraysIter_next(DelimitedArraysIterObject *self) {
+    AK_DelimitedReader *dr = self->dr;
+    if (dr == NULL) return NULL;
+
+    AK_CodePointGrid *cpg = self->cpg;
+    // with axis 0, each record is a line, and dtypes must be called with the position of the record in all records
+    AK_CPG_Clear(cpg, self->axis == 0 ? self->records : 0);
+    dr->record_number = -1; // lines are loaded from position 0 for axis 0
+
+    int status = AK_DR_ProcessRecords(dr, cpg, &self->line_select, self->chunk_records);
+    if (status == -1) {
+        AK_DR_Free(dr);
+        self->dr = NULL;
+        return NULL;
+    }
+    Py_ssize_t records = dr->record_number + 1;
+    if (status == 0) {
+        AK_DR_Free(dr);
+        self->dr = NULL;
+    }
+    if (records == 0) return NULL;
+
+    self->records += records;
+    return AK_CPG_ToArrayList(cpg,
+            self->axis,
+            &self->line_select,
+            self->categorical_select,
+            self->tsep,
+            self->decc,
+            self->threads);
+}
+
+static PyObject *
+DelimitedArraysIter_iternext(DelimitedArraysIterObject *self) {
+    if (self->running) {
+        PyErr_SetString(PyExc_ValueError, "iterator already executing");
+        return NULL;
+    }
+    self->running = true;
+    PyObject *post = DelimitedArraysIter_next(self);
+    self->running = false;
+    return post;
+}
+
+static PyTypeObject DelimitedArraysIterType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_basicsize = sizeof(DelimitedArraysIterObject),
+    .tp_clear = (inquiry) DelimitedArraysIter_clear,
+    .tp_dealloc = (destructor) DelimitedArraysIter_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_iter = (getiterfunc) DelimitedArraysIter_iter,
+    .tp_iternext = (iternextfunc) DelimitedArraysIter_iternext,
+    .tp_name = "arraykit.DelimitedArraysIterator",
+    .tp_traverse = (traverseproc) DelimitedArraysIter_traverse,
+};
+
+static char *iter_delimited_to_arrays_kwarg_names[] = {
+    "file_like",
+    "chunk_records",
+    "axis",
+    "dtypes",
+    "line_select",
+    "row_filter",
+    "categorical",
+    "narrow_int",
+    "narrow_float",
+    "na_values",
+    "skiprows",
+    "nrows",
+    "delimiter",
+    "doublequote",
+    "escapechar",
+    "quotechar",
+    "quoting",
+    "skipinitialspace",
+    "strict",
+    "thousandschar",
+    "decimalchar",
+    "threads",
+    NULL
+};
+
+// Return an iterator of lists of arrays, as returned by delimited_to_arrays, for every `chunk_records` records. Types are evaluated independently for each chunk. Threads are only used for converting lines to arrays.
+static PyObject*
+iter_delimited_to_arrays(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
+{
+    PyObject *file_like;
+    Py_ssize_t chunk_records = 0; // required
+    int axis = 0;
+    PyObject *dtypes = NULL;
+    PyObject *line_select = NULL;
+    PyObject *row_filter = NULL;
+    PyObject *categorical = NULL;
+    int narrow_int = 0;
+    int narrow_float = 0;
+    PyObject *na_values = NULL;
+    PyObject *skiprows = NULL;
+    PyObject *nrows = NULL;
+    PyObject *delimiter = NULL;
+    PyObject *doublequote = NULL;
+    PyObject *escapechar = NULL;
+    PyObject *quotechar = NULL;
+    PyObject *quoting = NULL;
+    PyObject *skipinitialspace = NULL;
+    PyObject *strict = NULL;
+    PyObject *thousandschar = NULL;
+    PyObject *decimalchar = NULL;
+    int threads = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs,
+            "O|$niOOOOppOOOOOOOOOOOOi:iter_delimited_to_arrays",
+            iter_delimited_to_arrays_kwarg_names,
+            &file_like,
+            // kwarg only
+            &chunk_records,
+            &axis,
+            &dtypes,
+            &line_select,
+            &row_filter,
+            &categorical,
+            &narrow_int,
+            &narrow_float,
+            &na_values,
+            &skiprows,
+            &nrows,
+            &delimiter,
+            &doublequote,
+            &escapechar,
+            &quotechar,
+            &quoting,
+            &skipinitialspace,
+            &strict,
+            &thousandschar,
+            &decimalchar,
+            &threads))
+        return NULL;
+
+    if ((axis < 0) || (axis > 1)) {
+        PyErr_SetString(PyExc_ValueError, "Axis must be 0 or 1");
+        return NULL;
+    }
+    if (chunk_records < 1) {
+        PyErr_SetString(PyExc_ValueError, "chunk_records must be greater than zero");
+        return NULL;
+    }
+    if (threads < 1) {
+        PyErr_SetString(PyExc_ValueError, "threads must be greater than zero");
+        return NULL;
+    }
+    Py_ssize_t skiprows_count;
+    if (AK_set_count("skiprows", &skiprows_count, skiprows, 0)) return NULL;
+    Py_ssize_t nrows_count;
+    if (AK_set_count("nrows", &nrows_count, nrows, -1)) return NULL;
+    Py_UCS4 tsep;
+    if (AK_set_char("thousandschar", &tsep, thousandschar, '\0')) return NULL;
+    Py_UCS4 decc;
+    if (AK_set_char("decimalchar", &decc, decimalchar, '.')) return NULL;
+
+    DelimitedArraysIterObject *it = PyObject_GC_New(DelimitedArraysIterObject,
+            &DelimitedArraysIterType);
+    if (it == NULL) return NULL;
+    it->dr = NULL;
+    it->cpg = NULL;
+    it->line_select = (AK_LineSelect){NULL, NULL, 0, 0, NULL, 0};
+    it->categorical = (AK_LineSelect){NULL, NULL, 0, 0, NULL, 0};
+    it->categorical_select = NULL;
+    it->na_values = NULL;
+    it->chunk_records = chunk_records;
+    it->records = 0;
+    it->axis = axis;
+    it->tsep = tsep;
+    it->decc = decc;
+    it->threads = threads;
+    it->running = false;
+
+    if (AK_LS_Set(&it->line_select, line_select)
+            || AK_LS_SetCategorical(&it->categorical, categorical, &it->categorical_select)) {
+        Py_DECREF(it);
+        return NULL;
+    }
+    it->na_values = AK_NA_New(na_values);
+    if (it->na_values == NULL && PyErr_Occurred()) {
+        Py_DECREF(it);
+        return NULL;
+    }
+    it->cpg = AK_CPG_New(dtypes, tsep, decc);
+    if (it->cpg == NULL) {
+        Py_DECREF(it);
+        return NULL;
+    }
+    it->cpg->narrow_int = narrow_int;
+    it->cpg->narrow_float = narrow_float;
+    it->cpg->na_values = it->na_values;
+
+    it->dr = AK_DR_New(file_like,
+            axis,
+            delimiter,
+            doublequote,
+            escapechar,
+            quotechar,
+            quoting,
+            skipinitialspace,
+            strict);
+    if (it->dr == NULL || AK_DR_SetRowFilter(it->dr, row_filter, tsep, decc)) {
+        Py_DECREF(it);
+        return NULL;
+    }
+    it->dr->skiprows = skiprows_count;
+    it->dr->nrows_remaining = nrows_count;
+    PyObject_GC_Track(it);
+    return (PyObject*)it;
+}
+
+static char *delimited_infer_schema_kwarg_names[] = {
+    "file_like",
+    "dtypes",
+    "line_select",
+    "row_filter",
+    "narrow_int",
+    "narrow_float",
+    "na_values",
+    "skiprows",
+    "nrows",
+    "delimiter",
+    "doublequote",
+    "escapechar",
+    "quotechar",
+    "quoting",
+    "skipinitialspace",
+    "strict",
+    "thousandschar",
+    "decimalchar",
+    NULL
+};
+
+// Return a tuple of a list of the dtypes of each column, as delimited_to_arrays would create with axis 1, and the count of records read. Fields are type parsed as they are tokenized but not retained, such that memory is proportional to the number of columns; `nrows` can bound the records read.
+static PyObject*
+delimited_infer_schema(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwargs)
+{
+    PyObject *file_like;
+    PyObject *dtypes = NULL;
+    PyObject *line_select = NULL;
+    PyObject *row_filter = NULL;
+    int narrow_int = 0;
+    int narrow_float = 0;
+    PyObject *na_values = NULL;
+    PyObject *skiprows = NULL;
+    PyObject *nrows = NULL;
+    PyObject *delimiter = NULL;
+    PyObject *doublequote = NULL;
+    PyObject *escapechar = NULL;
+    PyObject *quotechar = NULL;
+    PyObject *quoting = NULL;
+    PyObject *skipinitialspace = NULL;
+    PyObject *strict = NULL;
+    PyObject *thousandschar = NULL;
+    PyObject *decimalchar = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs,
+            "O|$OOOppOOOOOOOOOOOO:delimited_infer_schema",
+            delimited_infer_schema_kwarg_names,
+            &file_like,
+            // kwarg only
+            &dtypes,
+            &line_select,
+            &row_filter,
+            &narrow_int,
+            &narrow_float,
+            &na_values,
+            &skiprows,
+            &nrows,
+            &delimiter,
+            &doublequote,
+            &escapechar,
+            &quotechar,
+            &quoting,
+            &skipinitialspace,
+            &strict,
+            &thousandschar,
+            &decimalchar))
+        return NULL;
+
+    Py_ssize_t skiprows_count;
+    if (AK_set_count("skiprows", &skiprows_count, skiprows, 0)) return NULL;
+    Py_ssize_t nrows_count;
+    if (AK_set_count("nrows", &nrows_count, nrows, -1)) return NULL;
+    Py_UCS4 tsep;
+    if (AK_set_char("thousandschar", &tsep, thousandschar, '\0')) return NULL;
+    Py_UCS4 decc;
+    if (AK_set_char("decimalchar", &decc, decimalchar, '.')) return NULL;
+
+    PyObject *result = NULL;
+    AK_DelimitedReader *dr = NULL;
+    AK_CodePointGrid *cpg = NULL;
+    AK_NAValues *na = AK_NA_New(na_values);
+    if (na == NULL && PyErr_Occurred()) return NULL;
+    AK_LineSelect ls;
+    if (AK_LS_Set(&ls, line_select)) {
+        AK_NA_Free(na);
+        return NULL;
+    }
+    dr = AK_DR_New(file_like,
+            1,
+            delimiter,
+            doublequote,
+            escapechar,
+            quotechar,
+            quoting,
+            skipinitialspace,
+            strict);
+    if (dr == NULL || AK_DR_SetRowFilter(dr, row_filter, tsep, decc)) goto exit;
+    dr->skiprows = skiprows_count;
+    dr->nrows_remaining = nrows_count;
+
+    cpg = AK_CPG_New(dtypes, tsep, decc);
+    if (cpg == NULL) goto exit;
+    cpg->narrow_int = narrow_int;
+    cpg->narrow_float = narrow_float;
+    cpg->na_values = na;
+    cpg->discard = true;
+
+    if (AK_DR_ProcessRecords(dr, cpg, &ls, -1) == -1) goto exit;
+
+    PyObject *list = AK_CPG_ToDtypeList(cpg, &ls);
+    if (list == NULL) goto exit;
+    result = Py_BuildValue("(Nn)", list, dr->record_number + 1);
+exit:
+    if (dr) AK_DR_Free(dr);
+    if (cpg) AK_CPG_Free(cpg);
+    AK_LS_Clear(&ls);
+    AK_NA_Free(na);
+    return result;
+}
+
 static char *iterable_str_to_array_1d_kwarg_names[] = {
     "iterable",
     "dtype",
     "thousandschar",
     "decimalchar",
+    "na_values",
     NULL
 };
 
@@ -2965,15 +8261,17 @@ iterable_str_to_array_1d(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwarg
     PyObject *dtype_specifier = NULL;
     PyObject *thousandschar = NULL;
     PyObject *decimalchar = NULL;
+    PyObject *na_values = NULL;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwargs,
-            "O|OOO:iterable_str_to_array_1d",
+            "O|OOOO:iterable_str_to_array_1d",
             iterable_str_to_array_1d_kwarg_names,
             &iterable,
             // kwarg only
             &dtype_specifier,
             &thousandschar,
-            &decimalchar))
+            &decimalchar,
+            &na_values))
         return NULL;
 
     Py_UCS4 tsep;
@@ -2990,7 +8288,12 @@ iterable_str_to_array_1d(PyObject *Py_UNUSED(m), PyObject *args, PyObject *kwarg
             decimalchar,
             '.')) return NULL;
 
-    return AK_IterableStrToArray1D(iterable, dtype_specifier, tsep, decc);
+    AK_NAValues *na = AK_NA_New(na_values);
+    if (na == NULL && PyErr_Occurred()) return NULL;
+
+    PyObject *array = AK_IterableStrToArray1D(iterable, dtype_specifier, tsep, decc, na);
+    AK_NA_Free(na);
+    return array;
 }
 
 static char *split_after_count_kwarg_names[] = {
@@ -6845,6 +12148,14 @@ static PyMethodDef arraykit_methods[] =  {
             (PyCFunction)delimited_to_arrays,
             METH_VARARGS | METH_KEYWORDS,
             NULL},
+    {"iter_delimited_to_arrays",
+            (PyCFunction)iter_delimited_to_arrays,
+            METH_VARARGS | METH_KEYWORDS,
+            NULL},
+    {"delimited_infer_schema",
+            (PyCFunction)delimited_infer_schema,
+            METH_VARARGS | METH_KEYWORDS,
+            NULL},
     {"iterable_str_to_array_1d",
             (PyCFunction)iterable_str_to_array_1d,
             METH_VARARGS | METH_KEYWORDS,
@@ -6910,6 +12221,7 @@ PyInit__arraykit(void)
         PyType_Ready(&BIIterBlockType) ||
         PyType_Ready(&TriMapType) ||
         PyType_Ready(&ArrayGOType) ||
+        PyType_Ready(&DelimitedArraysIterType) ||
         PyModule_AddObject(m, "BlockIndex", (PyObject *) &BlockIndexType) ||
         PyModule_AddObject(m, "TriMap", (PyObject *) &TriMapType) ||
         PyModule_AddObject(m, "ArrayGO", (PyObject *) &ArrayGOType) ||
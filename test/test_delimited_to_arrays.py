@@ -1,9 +1,13 @@
 import unittest
 import datetime
 import csv
+import gc
+import weakref
 import numpy as np
 
 from arraykit import delimited_to_arrays
+from arraykit import iter_delimited_to_arrays
+from arraykit import delimited_infer_schema
 from arraykit import iterable_str_to_array_1d
 
 
@@ -290,6 +294,13 @@ class TestUnit(unittest.TestCase):
         self.assertEqual(a1.dtype, np.dtype(np.float16))
         self.assertFalse(a1.flags.writeable)
 
+    def test_iterable_str_to_array_1d_float_13(self) -> None:
+        # trailing white space is ignored
+        a1 = iterable_str_to_array_1d(['15\t', '1e5\t', '-1\t', '15\n', 'inf\r', 'nan\f'], dtype=float)
+        self.assertEqual(str(a1.tolist()), '[15.0, 100000.0, -1.0, 15.0, inf, nan]')
+        a2 = iterable_str_to_array_1d(['123456789012345678901234.5\v'], dtype=float)
+        self.assertEqual(a2.tolist(), [123456789012345678901234.5])
+
 
     #---------------------------------------------------------------------------
 
@@ -385,6 +396,24 @@ class TestUnit(unittest.TestCase):
         with self.assertRaises(ValueError):
             a1 = iterable_str_to_array_1d(['-2+1.2asdfj', '1.5wer4.2j'], complex)
 
+    def test_iterable_str_to_array_1d_complex_7(self) -> None:
+        values = ['1', '2.5j', '-j', '+J', ' (1e3-2.5e-2J) ', '0.1+0.2j', 'nan-infj', '1-j', '( 7 )']
+        for dtype in (np.complex64, np.complex128):
+            a1 = iterable_str_to_array_1d(values, dtype)
+            self.assertEqual(a1.dtype, np.dtype(dtype))
+            self.assertEqual(str(a1.tolist()), str(np.array([complex(v) for v in values]).astype(dtype).tolist()))
+
+    def test_iterable_str_to_array_1d_complex_8(self) -> None:
+        # forms not parsed natively are given to NumPy
+        a1 = iterable_str_to_array_1d(['1+2j', '1_0+2j', '1e400+1j'], complex)
+        self.assertEqual(a1.tolist(), [1+2j, 10+2j, complex('inf+1j')])
+        with self.assertRaises(ValueError):
+            _ = iterable_str_to_array_1d(['1+2j', ''], complex)
+
+    def test_iterable_str_to_array_1d_complex_9(self) -> None:
+        a1 = iterable_str_to_array_1d(['1,5+2j', '-3,25j'], complex, decimalchar=',')
+        self.assertEqual(a1.tolist(), [1.5+2j, -3.25j])
+
     #---------------------------------------------------------------------------
 
     def test_iterable_str_to_array_1d_dt64_1(self) -> None:
@@ -409,6 +438,46 @@ class TestUnit(unittest.TestCase):
         with self.assertRaises(ValueError):
             _ = iterable_str_to_array_1d(['202.30', '202.20'], 'datetime64[D]')
 
+    def test_iterable_str_to_array_1d_dt64_5(self) -> None:
+        values = ['2020-01-01T10:30:05.25', '1969-12-31 23:59', '', 'NaT', '1600-02-29T01']
+        for unit in ('Y', 'M', 'W', 'D', 'h', 'm', 's', 'ms', 'us', 'ns'):
+            dtype = np.dtype(f'datetime64[{unit}]')
+            a1 = iterable_str_to_array_1d(values, dtype)
+            self.assertEqual(a1.dtype, dtype)
+            self.assertEqual(a1.tolist(), np.array(values).astype(dtype).tolist())
+
+    def test_iterable_str_to_array_1d_dt64_6(self) -> None:
+        a1 = iterable_str_to_array_1d(['2020-01-01', '2020-01-01T10:00:00.5', 'NaT'], np.datetime64)
+        self.assertEqual(a1.dtype, np.dtype('<M8[ms]'))
+        self.assertEqual(a1.astype(str).tolist(),
+                ['2020-01-01T00:00:00.000', '2020-01-01T10:00:00.500', 'NaT'])
+
+        a2 = iterable_str_to_array_1d(['', 'NaT'], np.datetime64)
+        self.assertEqual(a2.dtype, np.dtype('<M8'))
+        self.assertEqual(a2.astype(str).tolist(), ['NaT', 'NaT'])
+
+    def test_iterable_str_to_array_1d_dt64_7(self) -> None:
+        # timezone offsets are applied, converting to UTC
+        a1 = iterable_str_to_array_1d(
+                ['2020-01-01T00:30Z', '2020-01-01T00:30+01:00', '2020-12-31T23:00-0130'],
+                np.datetime64)
+        self.assertEqual(a1.astype(str).tolist(),
+                ['2020-01-01T00:30', '2019-12-31T23:30', '2021-01-01T00:30'])
+
+        a2 = iterable_str_to_array_1d(['2020-01-01T00:30+01:00'], 'datetime64[M]')
+        self.assertEqual(a2.astype(str).tolist(), ['2019-12'])
+
+    def test_iterable_str_to_array_1d_dt64_8(self) -> None:
+        # formats not parsed natively are given to NumPy
+        a1 = iterable_str_to_array_1d(['2020-01-01', '-0100-01-01'], 'datetime64[D]')
+        self.assertEqual(a1.astype(str).tolist(), ['2020-01-01', '-100-01-01'])
+
+        with self.assertRaises(ValueError):
+            _ = iterable_str_to_array_1d(['2020-01-01', '2021-02-29'], 'datetime64[D]')
+
+        a2 = iterable_str_to_array_1d(['3000-01-01'], 'datetime64[ns]')
+        self.assertEqual(a2.tolist(), np.array(['3000-01-01']).astype('datetime64[ns]').tolist())
+
     #---------------------------------------------------------------------------
 
     def test_iterable_str_to_array_1d_parse_1(self) -> None:
@@ -725,7 +794,8 @@ class TestUnit(unittest.TestCase):
             '2022,2022-05-01,3',
             ]
         post1 = delimited_to_arrays(msg, axis=1, skipinitialspace=False)
-        self.assertEqual([a.tolist() for a in post1], [[2021, 2022], ['2021-04-01', '2022-05-01'], [4, 3]])
+        self.assertEqual(post1[1].dtype, np.dtype('datetime64[D]'))
+        self.assertEqual([a.astype(str).tolist() for a in post1], [['2021', '2022'], ['2021-04-01', '2022-05-01'], ['4', '3']])
 
 
     def test_delimited_to_arrays_parse_k(self) -> None:
@@ -803,6 +873,34 @@ class TestUnit(unittest.TestCase):
                 ['[1.2, 3.5]', '[9.2, 2.3]']
                 )
 
+    def test_delimited_to_arrays_float_e(self) -> None:
+        # values that require correct rounding of the full mantissa
+        values = [
+            '9007199254740993',
+            '2.2250738585072011e-308',
+            '4.9406564584124654e-324',
+            '0.1000000000000000055511151231257827',
+            '1.7976931348623157e308',
+            '123456789012345678901234567890.5',
+            '0.000000000000000000000000123456789012345678901',
+            '7.038531e-26',
+            ]
+        post1 = delimited_to_arrays(values, axis=1, dtypes=lambda i: float)
+        self.assertEqual(post1[0].tolist(), [float(v) for v in values])
+
+    def test_delimited_to_arrays_float_f(self) -> None:
+        values = [repr(v) for v in np.random.default_rng(0).random(1000) * 1e6]
+        values.extend(repr(v) for v in np.random.default_rng(1).random(1000) * 1e-200)
+        post1 = delimited_to_arrays(['|'.join(values)], delimiter='|', axis=1)
+        self.assertEqual([a[0] for a in post1], [float(v) for v in values])
+
+    def test_delimited_to_arrays_float_g(self) -> None:
+        msg = ['"1.5\n",2\t', '"3\t",4.25\t']
+        post1 = delimited_to_arrays(msg, axis=1, quoting=csv.QUOTE_MINIMAL)
+        self.assertEqual([a.tolist() for a in post1], [[1.5, 3.0], [2.0, 4.25]])
+        post2 = delimited_to_arrays(msg, axis=1, quoting=csv.QUOTE_MINIMAL, dtypes=lambda i: float)
+        self.assertEqual([a.tolist() for a in post2], [[1.5, 3.0], [2.0, 4.25]])
+
     #---------------------------------------------------------------------------
     def test_delimited_to_arrays_int_a(self) -> None:
         msg = [
@@ -1020,6 +1118,346 @@ class TestUnit(unittest.TestCase):
         post1 = delimited_to_arrays(msg, axis=1, line_select=lambda i: False)
         self.assertEqual([x.tolist() for x in post1], [])
 
+    def test_delimited_to_arrays_line_select_g(self) -> None:
+        msg  = ['a,3,True,c', 'b,-1,False,d']
+        post1 = delimited_to_arrays(msg, axis=1, line_select=np.array([True, False, True]))
+        self.assertEqual([x.tolist() for x in post1], [['a', 'b'], [True, False]])
+        post2 = delimited_to_arrays(msg, axis=1, line_select=np.array([3, 0]))
+        self.assertEqual([x.tolist() for x in post2], [['a', 'b'], ['c', 'd']])
+        post3 = delimited_to_arrays(msg, axis=1, line_select=[])
+        self.assertEqual([x.tolist() for x in post3], [])
+
+    def test_delimited_to_arrays_line_select_h(self) -> None:
+        msg = ['1,2', 'False,True', 'foo,bar', '3.2,5.2']
+        post1 = delimited_to_arrays(msg, axis=0, line_select=[False, True, True])
+        self.assertEqual([x.tolist() for x in post1], [[False, True], ['foo', 'bar']])
+        post2 = delimited_to_arrays(msg.__iter__(), axis=0, line_select=np.array([3], dtype=np.uint8))
+        self.assertEqual([x.tolist() for x in post2], [[3.2, 5.2]])
+        post3 = delimited_to_arrays('\n'.join(msg).encode(), axis=0, line_select=(0, 3))
+        self.assertEqual([x.tolist() for x in post3], [[1, 2], [3.2, 5.2]])
+
+    def test_delimited_to_arrays_line_select_i(self) -> None:
+        msg = ['1,2', '3,4']
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(msg, axis=1, line_select=[0, -1])
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(msg, axis=1, line_select=np.array([[True]]))
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(msg, axis=1, line_select=['a'])
+
+    def test_delimited_to_arrays_line_select_j(self) -> None:
+        # columns not selected are not type parsed, so need not be valid for any dtype
+        msg = ['1,"x,y",2.5,a', '3,"z\nw",4.5', '5']
+        post1 = delimited_to_arrays(msg, axis=1, line_select=[0, 2], dtypes=[int, int, None])
+        self.assertEqual([x.tolist() for x in post1], [[1, 3, 5], [2.5, 4.5]])
+        post2 = delimited_to_arrays(msg, axis=1, line_select=lambda i: i == 3)
+        self.assertEqual([x.tolist() for x in post2], [['a']])
+        post3 = delimited_to_arrays(msg, axis=1, line_select=[True, False, False, True])
+        self.assertEqual([x.tolist() for x in post3], [[1, 3, 5], ['a']])
+
+    def test_delimited_to_arrays_line_select_k(self) -> None:
+        calls = []
+        def line_select(i: int) -> bool:
+            calls.append(i)
+            return i % 2 == 1
+        msg = ['a,b,c,d', 'e,f,g', 'h,i,j,k,l']
+        post = delimited_to_arrays(msg, axis=1, line_select=line_select)
+        self.assertEqual([x.tolist() for x in post], [['b', 'f', 'i'], ['d', 'k']])
+        # called once per column
+        self.assertEqual(calls, [0, 1, 2, 3, 4])
+
+        with self.assertRaises(RuntimeError):
+            _ = delimited_to_arrays(msg, axis=1, line_select=lambda i: 1 / (i - 2))
+
+    def test_delimited_to_arrays_line_select_l(self) -> None:
+        msg = b''.join(b'%d,x,%d.5,"y",z\n' % (i, i) for i in range(50_000))
+        for line_select in ([0, 2], np.array([True, False, True]), lambda i: i in (0, 2)):
+            post1 = delimited_to_arrays(msg, axis=1, line_select=line_select, threads=1)
+            post2 = delimited_to_arrays(msg, axis=1, line_select=line_select, threads=4)
+            self.assertEqual(len(post2), 2)
+            for a, b in zip(post1, post2):
+                self.assertEqual(a.dtype, b.dtype)
+                self.assertTrue((a == b).all())
+
+    def test_delimited_to_arrays_line_select_m(self) -> None:
+        # a large position is not resolved into a flag per position
+        msg = ['1,2,3', '4,5,6', '7,8,9']
+        post1 = delimited_to_arrays(msg, axis=1, line_select=[10**10, 2, 0])
+        self.assertEqual([x.tolist() for x in post1], [[1, 4, 7], [3, 6, 9]])
+        post2 = delimited_to_arrays(msg, axis=0, line_select=np.array([1, 10**12]))
+        self.assertEqual([x.tolist() for x in post2], [[4, 5, 6]])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_dtypes_a(self) -> None:
+        msg = ['1,2,3', '4,5,6']
+        post1 = delimited_to_arrays(msg, axis=1, dtypes=[np.int8, None, str])
+        self.assertEqual([x.dtype.str for x in post1], ['|i1', '<i8', '<U1'])
+        post2 = delimited_to_arrays(msg, axis=1, dtypes=(float,))
+        self.assertEqual([x.dtype.str for x in post2], ['<f8', '<i8', '<i8'])
+        post3 = delimited_to_arrays(msg, axis=1, dtypes={2: 'S', 0: None})
+        self.assertEqual([x.dtype.str for x in post3], ['<i8', '<i8', '|S1'])
+
+    def test_delimited_to_arrays_dtypes_b(self) -> None:
+        msg = ['1,2', 'a,b', '3.5,4']
+        post1 = delimited_to_arrays(msg, axis=0, dtypes={1: 'U1', 2: np.float32})
+        self.assertEqual([x.dtype.str for x in post1], ['<i8', '<U1', '<f4'])
+        post2 = delimited_to_arrays(msg, axis=0, dtypes=[str], line_select=[1, 2])
+        self.assertEqual([x.tolist() for x in post2], [['a', 'b'], [3.5, 4.0]])
+
+    def test_delimited_to_arrays_dtypes_c(self) -> None:
+        msg = ['1,2']
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(msg, axis=1, dtypes='int')
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(msg, axis=1, dtypes=[int, 'foo'])
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(msg, axis=1, dtypes={-1: int})
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(msg, axis=1, dtypes={'a': int})
+
+    def test_delimited_to_arrays_dtypes_d(self) -> None:
+        msg = b''.join(b'1,2.5,x\n' for _ in range(50_000))
+        dtypes = [np.int32, np.float32, None]
+        post1 = delimited_to_arrays(msg, axis=1, dtypes=dtypes)
+        post2 = delimited_to_arrays(msg, axis=1, dtypes=dtypes, threads=4)
+        self.assertEqual([x.dtype.str for x in post2], ['<i4', '<f4', '<U1'])
+        self.assertEqual([x.tolist() for x in post2], [x.tolist() for x in post1])
+
+    def test_delimited_to_arrays_dtypes_e(self) -> None:
+        # int64, float64, and bool given in a sequence are converted while tokenizing
+        msg = ['1,2.5,true,x', ' 3 , 1e3 ,False,y', '-4,,TRUE,z', '5,NA,tru,w']
+        dtypes = [np.int64, np.float64, bool, None]
+        post1 = delimited_to_arrays(msg, axis=1, dtypes=dtypes, na_values=['NA'])
+        post2 = delimited_to_arrays(msg, axis=1, dtypes=lambda i: dtypes[i], na_values=['NA'])
+        self.assertEqual([x.dtype for x in post1], [x.dtype for x in post2])
+        for a1, a2 in zip(post1, post2):
+            np.testing.assert_array_equal(a1, a2)
+        self.assertEqual(post1[2].tolist(), [True, False, True, False])
+        post3 = delimited_to_arrays(['1,2', 'x,y', '3,4'], axis=0, dtypes={1: float}, row_filter=(0, {'1', '3'}))
+        self.assertEqual([x.tolist() for x in post3], [[1, 2], [3.0, 4.0]])
+
+    def test_delimited_to_arrays_dtypes_f(self) -> None:
+        with self.assertRaises(TypeError):
+            delimited_to_arrays(['1,a', '2,b'], axis=1, dtypes=[int, int])
+        with self.assertRaises(TypeError):
+            delimited_to_arrays(['1,2.5'], axis=0, dtypes=[int])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_row_filter_a(self) -> None:
+        msg = ['a,1,x', 'b,2,y', 'a,3,"q,r"', 'c,4.5,z', 'é,5,ü', 'a']
+        post1 = delimited_to_arrays(msg, axis=1, row_filter=(0, 'a'))
+        self.assertEqual([x.tolist() for x in post1], [['a', 'a', 'a'], [1, 3], ['x', 'q,r']])
+        post2 = delimited_to_arrays(msg, axis=0, row_filter=(0, {'c', 'é'}))
+        self.assertEqual([x.tolist() for x in post2], [['c', '4.5', 'z'], ['é', '5', 'ü']])
+        post3 = delimited_to_arrays(msg, axis=1, row_filter=(2, {'ü'}), line_select=[2])
+        self.assertEqual([x.tolist() for x in post3], [['ü']])
+
+    def test_delimited_to_arrays_row_filter_b(self) -> None:
+        # ranges are inclusive; fields that are not numbers fail
+        msg = ['a,1', 'b,2.5', 'c,x', 'd,', 'e,4', 'f,1e1']
+        post1 = delimited_to_arrays(msg, axis=1, row_filter=(1, (2.5, 4)))
+        self.assertEqual([x.tolist() for x in post1], [['b', 'e'], [2.5, 4.0]])
+        post2 = delimited_to_arrays(msg, axis=1, row_filter=[(1, (None, 5)), (0, {'a', 'f'})])
+        self.assertEqual([x.tolist() for x in post2], [['a'], [1]])
+        post3 = delimited_to_arrays(msg, axis=1, row_filter=(1, (5, None)))
+        self.assertEqual([x.tolist() for x in post3], [['f'], [10.0]])
+        post4 = delimited_to_arrays(msg, axis=1, row_filter=(0, 'z'))
+        self.assertEqual(post4, [])
+
+    def test_delimited_to_arrays_row_filter_c(self) -> None:
+        msg = ['1,2']
+        for row_filter in ('a', (0,), [(0, 'a'), 1], (0, 1), (0, {1}), (0, ('a', 1))):
+            with self.assertRaises(TypeError):
+                _ = delimited_to_arrays(msg, axis=1, row_filter=row_filter)
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(msg, axis=1, row_filter=(-1, 'a'))
+
+    def test_delimited_to_arrays_row_filter_d(self) -> None:
+        msg = b''.join(b'%d,k%d,%d.5\n' % (i, i % 10, i) for i in range(50_000))
+        post1 = delimited_to_arrays(msg, axis=1, row_filter=(1, 'k3'))
+        post2 = delimited_to_arrays(msg, axis=1, row_filter=(1, 'k3'), threads=4)
+        self.assertEqual(len(post1[0]), 5_000)
+        self.assertEqual([x.tolist() for x in post2], [x.tolist() for x in post1])
+        post3 = delimited_to_arrays(msg, axis=0, row_filter=(0, (10, 11)), threads=4)
+        self.assertEqual([x.tolist() for x in post3], [['10', 'k0', '10.5'], ['11', 'k1', '11.5']])
+
+    def test_delimited_to_arrays_row_filter_e(self) -> None:
+        # a wide character in a column not tested does not fail a range test
+        post1 = delimited_to_arrays(['a,1', '\u20ac,2', 'b,3'], axis=1, row_filter=(1, (0, 10)))
+        self.assertEqual([x.tolist() for x in post1], [['a', '\u20ac', 'b'], [1, 2, 3]])
+        post2 = delimited_to_arrays(['1,a', '2,b', '3,\U0001F600'], axis=1, row_filter=(0, (2, 10)))
+        self.assertEqual([x.tolist() for x in post2], [[2, 3], ['b', '\U0001F600']])
+        post3 = delimited_to_arrays(['\u20ac,%s1' % ('0' * 200)], axis=1, row_filter=(1, (1, 1)))
+        self.assertEqual([x.tolist() for x in post3], [['\u20ac'], [1]])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_categorical_a(self) -> None:
+        msg = ['AAPL,1,x', 'MSFT,2,y', 'AAPL,3,é', 'IBM,4,x']
+        post1 = delimited_to_arrays(msg, axis=1, categorical=True)
+        codes, uniques = post1[0]
+        self.assertEqual(codes.dtype, np.int8)
+        self.assertEqual(codes.tolist(), [0, 1, 0, 2])
+        self.assertEqual(uniques.tolist(), ['AAPL', 'MSFT', 'IBM'])
+        self.assertEqual(uniques.dtype.str, '<U4')
+        # only lines of a unicode dtype are encoded
+        self.assertEqual(post1[1].tolist(), [1, 2, 3, 4])
+        self.assertEqual([x.tolist() for x in post1[2]], [[0, 1, 2, 0], ['x', 'y', 'é']])
+
+        post2 = delimited_to_arrays(msg, axis=1, categorical=[2], line_select=[0, 2])
+        self.assertEqual(post2[0].tolist(), ['AAPL', 'MSFT', 'AAPL', 'IBM'])
+        self.assertEqual(post2[1][1].tolist(), ['x', 'y', 'é'])
+        post3 = delimited_to_arrays(msg, axis=1, categorical=lambda i: i == 0, dtypes={0: 'U2'})
+        self.assertEqual([x.tolist() for x in post3[0]], [[0, 1, 0, 2], ['AA', 'MS', 'IB']])
+        post4 = delimited_to_arrays(msg, axis=1, categorical=False)
+        self.assertEqual(post4[0].tolist(), ['AAPL', 'MSFT', 'AAPL', 'IBM'])
+
+    def test_delimited_to_arrays_categorical_b(self) -> None:
+        values = [f'v{i % 300}' for i in range(1_000)] + [str(i) for i in range(40_000)]
+        msg = '\n'.join(values).encode()
+        codes, uniques = delimited_to_arrays(msg, axis=1, dtypes=[str], categorical=True, threads=4)[0]
+        self.assertEqual(codes.dtype, np.int32)
+        self.assertEqual(len(uniques), 40_300)
+        self.assertEqual(uniques[codes].tolist(), values)
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_datetime_a(self) -> None:
+        msg = [
+            '2020-01-01,2020-01-01T10:30,2020-01-01 10:30:15.123,2021-02-29,2020-01',
+            ',2020-01-02T00,2020-01-01 10:30:15,2021-03-01,2020-02',
+            ]
+        post1 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([x.dtype.str for x in post1],
+                ['<M8[D]', '<M8[m]', '<M8[ms]', '<U10', '<U7'])
+        self.assertTrue(np.isnat(post1[0][1]))
+        self.assertEqual(post1[2].tolist(), np.array(
+                ['2020-01-01T10:30:15.123', '2020-01-01T10:30:15'], dtype='M8[ms]').tolist())
+        post2 = delimited_to_arrays(msg, axis=1, dtypes={0: str})
+        self.assertEqual(post2[0].tolist(), ['2020-01-01', ''])
+
+    def test_delimited_to_arrays_datetime_b(self) -> None:
+        post1 = iterable_str_to_array_1d(['2020-01-01', '2020-01-01T00:00:00.000000001'])
+        self.assertEqual(post1.dtype, np.dtype('M8[ns]'))
+        self.assertEqual(post1[1] - post1[0], np.timedelta64(1, 'ns'))
+        post2 = iterable_str_to_array_1d(['2020-01-01', '1'])
+        self.assertEqual(post2.dtype.kind, 'U')
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_na_values_a(self) -> None:
+        na_values = ('', 'NA', 'null', '-')
+        msg = ['1,2.5,2020-01-01,a,1+2j,NA', 'NA,-,null,-,NA,-', ',null,,x,3j,']
+        post1 = delimited_to_arrays(msg, axis=1, na_values=na_values)
+        self.assertEqual([x.dtype.str for x in post1],
+                ['<f8', '<f8', '<M8[D]', '<U1', '<c16', '<f8'])
+        self.assertEqual(post1[0][0], 1.0)
+        self.assertTrue(np.isnan(post1[0][1:]).all())
+        self.assertTrue(np.isnat(post1[2][1:]).all())
+        self.assertEqual(post1[3].tolist(), ['a', '', 'x'])
+        self.assertTrue(np.isnan(post1[4][1]))
+        post2 = delimited_to_arrays(msg, axis=1, na_values=na_values, narrow_float=True)
+        self.assertEqual(post2[0].dtype.str, '<f4')
+        post3 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual({x.dtype.kind for x in post3}, {'U'})
+
+    def test_delimited_to_arrays_na_values_b(self) -> None:
+        msg = ['1,a', 'NA,b', ',c']
+        # empty fields are only missing if given
+        post1 = delimited_to_arrays(msg, axis=1, na_values=['NA'])
+        self.assertEqual(post1[0].dtype.str, '<f8')
+        self.assertEqual(np.isnan(post1[0]).tolist(), [False, True, True])
+        post2 = list(iter_delimited_to_arrays(msg, chunk_records=1, axis=1, na_values=['NA']))
+        self.assertEqual([p[0].dtype.str for p in post2], ['<i8', '<f8', '<U1'])
+        post3 = iterable_str_to_array_1d(['1', 'NA', '3'], na_values=['NA'])
+        self.assertEqual(post3.dtype.str, '<f8')
+        self.assertEqual(np.isnan(post3).tolist(), [False, True, False])
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(msg, na_values='NA')
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(msg, na_values=[None])
+
+    def test_delimited_to_arrays_na_values_c(self) -> None:
+        # given integer and bool dtypes cannot hold an NA value; given str dtypes have an empty string
+        msg = ['1,True,a', 'NA,NA,NA', '3,False,c']
+        for dtypes in ([int], [None, bool], [np.uint8], lambda i: int):
+            with self.assertRaises(ValueError):
+                _ = delimited_to_arrays(msg, axis=1, dtypes=dtypes, na_values=['NA'])
+        with self.assertRaises(ValueError):
+            _ = iterable_str_to_array_1d(['1', 'NA'], int, na_values=['NA'])
+        post1 = delimited_to_arrays(msg, axis=1, dtypes=[float, None, str], na_values=['NA'])
+        self.assertEqual(post1[2].tolist(), ['a', '', 'c'])
+        # an inferred bool line with an NA value is a str line
+        self.assertEqual(post1[1].tolist(), ['True', '', 'False'])
+
+    def test_delimited_to_arrays_na_values_d(self) -> None:
+        msg = ['true,1', 'NA,NA', 'false,NA']
+        post1 = delimited_to_arrays(msg, axis=1, na_values=['NA'])
+        self.assertEqual([a.dtype.str for a in post1], ['<U5', '<f8'])
+        self.assertEqual(post1[0].tolist(), ['true', '', 'false'])
+        post2 = delimited_infer_schema(msg, na_values=['NA'])
+        self.assertEqual(post2[0], [a.dtype for a in post1])
+        post3 = delimited_to_arrays(msg, axis=0, na_values=['NA'])
+        self.assertEqual(post3[2].tolist(), ['false', ''])
+        post4 = delimited_to_arrays(['true,false'] * 3, axis=1, na_values=['NA'])
+        self.assertEqual([a.dtype.str for a in post4], ['|b1', '|b1'])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_narrow_a(self) -> None:
+        msg = [
+            '1,-128,300,-40000,5000000000,18446744073709551615,',
+            '127,0,-32768,1,0,0,3',
+            ]
+        post1 = delimited_to_arrays(msg, axis=1, narrow_int=True)
+        self.assertEqual([x.dtype.str for x in post1],
+                ['|i1', '|i1', '<i2', '<i4', '<i8', '<u8', '|i1'])
+        self.assertEqual(post1[5].tolist(), [18446744073709551615, 0])
+        self.assertEqual(post1[3].tolist(), [-40000, 1])
+        post2 = delimited_to_arrays(msg[1:], axis=1)
+        self.assertEqual({x.dtype.str for x in post2}, {'<i8'})
+
+    def test_delimited_to_arrays_narrow_b(self) -> None:
+        msg = ['1.5,1e3,123456.5,nan,1,a', '-2.25,2,1,inf,1.0,b']
+        post1 = delimited_to_arrays(msg, axis=1, narrow_float=True)
+        self.assertEqual([x.dtype.str for x in post1],
+                ['<f4', '<f8', '<f8', '<f4', '<f4', '<U1'])
+        self.assertEqual(post1[0].tolist(), [1.5, -2.25])
+        post2 = delimited_to_arrays(msg, axis=1, narrow_float=True, dtypes={0: float})
+        self.assertEqual(post2[0].dtype.str, '<f8')
+        post3 = delimited_to_arrays(msg, axis=1, narrow_int=True)
+        self.assertEqual(post3[0].dtype.str, '<f8')
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_nrows_a(self) -> None:
+        msg = ['h1,h2', 'a,"x\ny"', '1,2', '', '3,4', '5,6']
+        post1 = delimited_to_arrays(msg, axis=1, skiprows=2)
+        self.assertEqual([x.tolist() for x in post1], [[1, 3, 5], [2, 4, 6]])
+        post2 = delimited_to_arrays(msg, axis=1, skiprows=1, nrows=2)
+        self.assertEqual([x.tolist() for x in post2], [['a', '1'], ['x\ny', '2']])
+        post3 = delimited_to_arrays(msg, axis=0, skiprows=2, line_select=[0, 3])
+        self.assertEqual([x.tolist() for x in post3], [[1, 2], [5, 6]])
+        self.assertEqual(delimited_to_arrays(msg, axis=1, nrows=0), [])
+        self.assertEqual(delimited_to_arrays(msg, axis=1, skiprows=10), [])
+
+    def test_delimited_to_arrays_nrows_b(self) -> None:
+        # input is not read past nrows records
+        def records():
+            while True:
+                yield '1,2'
+        post = delimited_to_arrays(records(), axis=1, nrows=3)
+        self.assertEqual([x.tolist() for x in post], [[1, 1, 1], [2, 2, 2]])
+
+        msg = b''.join(b'%d,"a\nb"\n' % i for i in range(50_000))
+        post1 = delimited_to_arrays(msg, axis=1, skiprows=49_998, threads=4)
+        self.assertEqual([x.tolist() for x in post1], [[49_998, 49_999], ['a\nb', 'a\nb']])
+        post2 = delimited_to_arrays(msg, axis=1, skiprows=10, nrows=2, threads=4)
+        self.assertEqual(post2[0].tolist(), [10, 11])
+
+    def test_delimited_to_arrays_nrows_c(self) -> None:
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(['1,2'], axis=1, nrows=-1)
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(['1,2'], axis=1, skiprows=-1)
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(['1,2'], axis=1, skiprows='1')
+
     #---------------------------------------------------------------------------
     def test_delimited_to_arrays_thousandschar_a(self) -> None:
         msg = [
@@ -1111,6 +1549,531 @@ class TestUnit(unittest.TestCase):
 
 
 
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_buffer_a(self) -> None:
+        msg = b'a,3,True\nb,-1,False\n'
+        post1 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post1],
+                [['a', 'b'], [3, -1], [True, False]])
+
+        post2 = delimited_to_arrays(bytearray(msg), axis=0)
+        self.assertEqual([a.tolist() for a in post2],
+                [['a', '3', 'True'], ['b', '-1', 'False']])
+
+        post3 = delimited_to_arrays(memoryview(msg), axis=1)
+        self.assertEqual([a.tolist() for a in post3],
+                [['a', 'b'], [3, -1], [True, False]])
+
+    def test_delimited_to_arrays_buffer_b(self) -> None:
+        # no trailing newline, CRLF line endings, and empty lines
+        msg = b'1.5,x\r\n\r\n2.5,y'
+        post1 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post1], [[1.5, 2.5], ['x', 'y']])
+
+    def test_delimited_to_arrays_buffer_c(self) -> None:
+        # quoted fields can span lines
+        msg = b'"a\nb",1\n"c,d",2\n'
+        post1 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post1], [['a\nb', 'c,d'], [1, 2]])
+
+    def test_delimited_to_arrays_buffer_d(self) -> None:
+        msg = 'caf\u00e9,\u20ac,\U0001F600\nna\u00efve,$,x\n'
+        post1 = delimited_to_arrays(msg.encode('utf-8'), axis=1)
+        post2 = delimited_to_arrays(msg.split('\n'), axis=1)
+        self.assertEqual([a.tolist() for a in post1], [a.tolist() for a in post2])
+        self.assertEqual(post1[2].tolist(), ['\U0001F600', 'x'])
+
+    def test_delimited_to_arrays_buffer_e(self) -> None:
+        with self.assertRaises(UnicodeDecodeError):
+            _ = delimited_to_arrays(b'a,b\nc,\xff\n', axis=1)
+        with self.assertRaises(UnicodeDecodeError):
+            _ = delimited_to_arrays(b'a,\xe2\x82', axis=1)
+
+    def test_delimited_to_arrays_buffer_f(self) -> None:
+        msg = b'1,2\nFalse,True\nfoo,bar\n3.2,5.2\n'
+        post1 = delimited_to_arrays(msg, line_select=lambda i: i in (0, 2), axis=0)
+        self.assertEqual([x.tolist() for x in post1], [[1, 2], ['foo', 'bar']])
+
+    def test_delimited_to_arrays_buffer_g(self) -> None:
+        import mmap
+        import tempfile
+        msg = 'a,3,True\nb,-1,False\n'
+        with tempfile.TemporaryFile() as f:
+            f.write(msg.encode('utf-8'))
+            f.flush()
+            with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+                post1 = delimited_to_arrays(mm, axis=1)
+        self.assertEqual([a.tolist() for a in post1],
+                [['a', 'b'], [3, -1], [True, False]])
+
+    def test_delimited_to_arrays_buffer_h(self) -> None:
+        # arrays are treated as iterables of strings, not as buffers
+        msg = np.array(['a,3', 'b,4'])
+        post1 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post1], [['a', 'b'], [3, 4]])
+
+    def test_delimited_to_arrays_buffer_i(self) -> None:
+        # a quoted newline continues the record for axis 0
+        msg = '0,"a\nb",c\n1,x,y\n'
+        post1 = delimited_to_arrays(msg.encode('utf-8'), axis=0)
+        self.assertEqual([a.tolist() for a in post1], [['0', 'a\nb', 'c'], ['1', 'x', 'y']])
+        post2 = delimited_to_arrays(msg.splitlines(keepends=True), axis=0)
+        self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+
+    #---------------------------------------------------------------------------
+    @staticmethod
+    def _threads_msg(count: int) -> bytes:
+        records = []
+        for i in range(count):
+            name = f'"n{i}\n,""q"""' if i % 7 == 0 else f'n\u00e9{i}'
+            records.append(f'{i},{i / 4},{name},{i % 2 == 0}')
+        return ('\n'.join(records) + '\n').encode('utf-8')
+
+    def test_delimited_to_arrays_threads_a(self) -> None:
+        msg = self._threads_msg(40_000)
+        post1 = delimited_to_arrays(msg, axis=1)
+        for threads in (2, 3, 8):
+            post2 = delimited_to_arrays(msg, axis=1, threads=threads)
+            self.assertEqual([a.dtype for a in post2], [a.dtype for a in post1])
+            self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+        self.assertEqual(post1[2][7].tolist(), 'n7\n,"q"')
+
+    def test_delimited_to_arrays_threads_b(self) -> None:
+        msg = self._threads_msg(20_000)
+        post1 = delimited_to_arrays(msg, axis=0, dtypes=lambda i: str if i % 2 else None)
+        post2 = delimited_to_arrays(msg, axis=0, dtypes=lambda i: str if i % 2 else None, threads=4)
+        self.assertEqual(len(post1), 20_000)
+        self.assertEqual([a.dtype for a in post2], [a.dtype for a in post1])
+        self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+
+    def test_delimited_to_arrays_threads_c(self) -> None:
+        # ragged records, line_select for axis 1
+        msg = b''.join(b'1,2,3\n' if i % 1000 else b'1\n' for i in range(100_000))
+        post1 = delimited_to_arrays(msg, axis=1, line_select=lambda i: i != 1)
+        post2 = delimited_to_arrays(msg, axis=1, line_select=lambda i: i != 1, threads=4)
+        self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+        self.assertEqual(len(post2), 2)
+        self.assertEqual(len(post2[1]), 99_900)
+
+    def test_delimited_to_arrays_threads_d(self) -> None:
+        msg = b'1,2\n' * 100_000 + b'1,\xff\n' + b'1,2\n' * 100_000
+        with self.assertRaises(UnicodeDecodeError):
+            _ = delimited_to_arrays(msg, axis=1, threads=4)
+
+        msg = b'1,2\n' * 100_000 + b'1,"a"b\n' + b'1,2\n' * 100_000
+        with self.assertRaises(RuntimeError):
+            _ = delimited_to_arrays(msg, axis=1, threads=4, strict=True)
+
+    def test_delimited_to_arrays_threads_e(self) -> None:
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(b'1,2\n', axis=1, threads=0)
+        # small inputs and iterables are processed on one thread
+        post1 = delimited_to_arrays(b'1,2\n', axis=1, threads=4)
+        self.assertEqual([a.tolist() for a in post1], [[1], [2]])
+        post2 = delimited_to_arrays(['1,2'], axis=1, threads=4)
+        self.assertEqual([a.tolist() for a in post2], [[1], [2]])
+
+    def test_delimited_to_arrays_threads_f(self) -> None:
+        # conversion of many columns on threads, including dtypes converted serially
+        records = ['1,2.5,True,abc,2020-01-01,1+2j,7,x'] * 100
+        dtypes = lambda i: {4: 'datetime64[D]', 5: complex, 6: np.uint8, 7: 'S3'}.get(i)
+        post1 = delimited_to_arrays(records, axis=1, dtypes=dtypes)
+        post2 = delimited_to_arrays(records, axis=1, dtypes=dtypes, threads=4)
+        self.assertEqual([a.dtype for a in post2], [a.dtype for a in post1])
+        self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+        self.assertFalse(any(a.flags.writeable for a in post2))
+
+    def test_delimited_to_arrays_threads_g(self) -> None:
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(['1,x', '2,3'], axis=1, dtypes=lambda i: int, threads=4)
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(['1,x', '2,3'], axis=1, dtypes=lambda i: float, threads=4)
+        # the error of an earlier line filled on threads is raised before that of a later line
+        with self.assertRaises(TypeError):
+            _ = delimited_to_arrays(b'x,1\n2,y\n', axis=1, dtypes=[np.int64, 'timedelta64[s]'], threads=2)
+
+    def test_delimited_to_arrays_threads_h(self) -> None:
+        # datetime columns filled on threads, with one falling back to NumPy parsing
+        records = ['2020-01-01,2020-01-01T10:30,5', '2021-06-30,-0001-01-01T00:00,6'] * 100
+        dtypes = lambda i: np.datetime64 if i < 2 else None
+        post1 = delimited_to_arrays(records, axis=1, dtypes=dtypes, line_select=lambda i: i != 2)
+        post2 = delimited_to_arrays(records, axis=1, dtypes=dtypes, line_select=lambda i: i != 2, threads=4)
+        self.assertEqual([a.dtype for a in post2], [np.dtype('<M8[D]'), np.dtype('<M8[m]')])
+        self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+        self.assertEqual(post2[1][:2].astype(str).tolist(), ['2020-01-01T10:30', '-001-01-01T00:00'])
+        self.assertFalse(any(a.flags.writeable for a in post2))
+        with self.assertRaises(ValueError):
+            _ = delimited_to_arrays(['2020-01-01', 'x'], axis=1, dtypes=dtypes, threads=4)
+
+    def test_delimited_to_arrays_threads_i(self) -> None:
+        # line bounds found in later chunks determine narrowed and datetime dtypes
+        msg = b'1,2020-01-01,1.5\n' * 100_000 + b'300,2020-01-01T00:00:01,1e3\n'
+        post1 = delimited_to_arrays(msg, axis=1, narrow_int=True, narrow_float=True)
+        post2 = delimited_to_arrays(msg, axis=1, narrow_int=True, narrow_float=True, threads=4)
+        self.assertEqual([a.dtype.str for a in post2], ['<i2', '<M8[s]', '<f8'])
+        self.assertEqual([a.dtype for a in post2], [a.dtype for a in post1])
+        self.assertEqual([a[-1].item() for a in post2], [a[-1].item() for a in post1])
+
+    def test_delimited_to_arrays_threads_j(self) -> None:
+        # chunk boundaries found within quoted and escaped line breaks, with given dtypes
+        msg = b'1,"a\nb",2.5,x\\\ny\n' * 20_000 + b'2,"\n",3,z\n'
+        dtypes = [np.int64, str, np.float64]
+        post1 = delimited_to_arrays(msg, axis=1, dtypes=dtypes, escapechar='\\')
+        post2 = delimited_to_arrays(msg, axis=1, dtypes=dtypes, escapechar='\\', threads=4)
+        self.assertEqual([a.dtype.str for a in post2], ['<i8', '<U3', '<f8', '<U3'])
+        self.assertEqual([a.tolist() for a in post2], [a.tolist() for a in post1])
+        self.assertEqual(post2[1][-2:].tolist(), ['a\nb', '\n'])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_kind_a(self) -> None:
+        # code points of each width widen a column only as needed
+        msg = ['a,\u00e9', 'b,\u0101', 'c,\U0001F600', 'd,e']
+        post = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post],
+                [['a', 'b', 'c', 'd'], ['\u00e9', '\u0101', '\U0001F600', 'e']])
+
+    def test_delimited_to_arrays_kind_b(self) -> None:
+        msg = ['\u00e9,\u0101\u0101', 'x,\U0001F600', 'xyz,']
+        post = delimited_to_arrays(msg, axis=0)
+        self.assertEqual([a.tolist() for a in post],
+                [['\u00e9', '\u0101\u0101'], ['x', '\U0001F600'], ['xyz', '']])
+
+    def test_delimited_to_arrays_kind_c(self) -> None:
+        msg = ['\u0101bc,\U0001F600yz']
+        post = delimited_to_arrays(msg, axis=1, dtypes=lambda i: (str, bytes)[i])
+        self.assertEqual([a.tolist() for a in post], [['\u0101bc'], [b'\x00yz']])
+
+    def test_delimited_to_arrays_kind_d(self) -> None:
+        # a column widened beyond 1-byte code points cannot hold numbers
+        with self.assertRaises(TypeError):
+            delimited_to_arrays(['1', '\u0101'], axis=1, dtypes=lambda i: int)
+        with self.assertRaises(TypeError):
+            delimited_to_arrays(['1.5', '\u0101'], axis=1, dtypes=lambda i: float)
+        post = delimited_to_arrays(['true', '\u0101'], axis=1, dtypes=lambda i: bool)
+        self.assertEqual(post[0].tolist(), [True, False])
+
+    def test_delimited_to_arrays_kind_e(self) -> None:
+        # chunks of different widths are stitched together
+        records = [f'{i},x{i}' for i in range(30_000)]
+        records.append('0,\U0001F600')
+        records.extend(f'{i},\u0101{i}' for i in range(30_000))
+        msg = ('\n'.join(records) + '\n').encode('utf-8')
+        post1 = delimited_to_arrays(msg, axis=1)
+        post2 = delimited_to_arrays(msg, axis=1, threads=4)
+        self.assertEqual(post2[1][30_000], '\U0001F600')
+        for a, b in zip(post1, post2):
+            self.assertEqual(a.tolist(), b.tolist())
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_capacity_a(self) -> None:
+        # records much wider or narrower than the previous record
+        records = ['1', ','.join(['x' * 100] * 100), 'a,b', ','.join(map(str, range(500))), 'z']
+        post = delimited_to_arrays(records, axis=0)
+        self.assertEqual([len(a) for a in post], [1, 100, 2, 500, 1])
+        self.assertEqual(post[1][99], 'x' * 100)
+        self.assertEqual(post[3].tolist(), list(range(500)))
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_scan_a(self) -> None:
+        # runs longer than a vector width, ending with each structural character
+        field = 'abcdefghijklmnopqrstuvwxyz0123456789' * 2
+        msg = [f'{field},"{field}, {field}",{field}\u00e9{field}']
+        for src in (msg, msg[0].encode('utf-8')):
+            post = delimited_to_arrays(src, axis=0)
+            self.assertEqual(post[0].tolist(),
+                    [field, f'{field}, {field}', f'{field}\u00e9{field}'])
+
+    def test_delimited_to_arrays_scan_b(self) -> None:
+        field = 'x' * 40
+        msg = [f'{field}\\,{field},"{field}\\"{field}"']
+        post = delimited_to_arrays(msg, axis=0, escapechar='\\')
+        self.assertEqual(post[0].tolist(), [f'{field},{field}', f'{field}"{field}'])
+
+    def test_delimited_to_arrays_scan_c(self) -> None:
+        # type parsing is applied to characters appended in runs
+        msg = ['1234567890123456789,1234567.12345678901,12345678901234567x']
+        post = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.dtype.kind for a in post], ['i', 'f', 'U'])
+        self.assertEqual(post[0][0], 1234567890123456789)
+
+    def test_delimited_to_arrays_scan_d(self) -> None:
+        # an empty line does not create a record
+        post1 = delimited_to_arrays(['1', '', '9'], axis=0)
+        self.assertEqual([a.tolist() for a in post1], [[1], [9]])
+        post2 = delimited_to_arrays(b'1\n\n9\n', axis=0)
+        self.assertEqual([a.tolist() for a in post2], [[1], [9]])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_split_a(self) -> None:
+        # lines with and without quotes
+        msg = ['a,b,', '"a,b",c,d', 'x,,y\r\n', '\u00e9,\u0101\u0101,z']
+        post = delimited_to_arrays(msg, axis=0)
+        self.assertEqual([a.tolist() for a in post],
+                [['a', 'b', ''], ['a,b', 'c', 'd'], ['x', '', 'y'], ['\u00e9', '\u0101\u0101', 'z']])
+        post = delimited_to_arrays('\n'.join(msg).encode('utf-8'), axis=0)
+        self.assertEqual(post[3].tolist(), ['\u00e9', '\u0101\u0101', 'z'])
+
+    def test_delimited_to_arrays_split_b(self) -> None:
+        msg = ['"a",b', 'c,"d']
+        post = delimited_to_arrays(msg, axis=1, quoting=csv.QUOTE_NONE)
+        self.assertEqual([a.tolist() for a in post], [['"a"', 'c'], ['b', '"d']])
+
+    def test_delimited_to_arrays_split_c(self) -> None:
+        post = delimited_to_arrays(['a\u00e9b\u00e9c', '1\u00e92\u00e9'], axis=0, delimiter='\u00e9')
+        self.assertEqual([a.tolist() for a in post], [['a', 'b', 'c'], [1, 2, 0]])
+
+    def test_delimited_to_arrays_split_d(self) -> None:
+        with self.assertRaises(UnicodeDecodeError):
+            delimited_to_arrays(b'a,b\nc,\xff\n', axis=0)
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_preallocate_a(self) -> None:
+        # the count of records might not match records tokenized
+        msgs = [b'', b'1,2', b'1,2\n3,4\n', b'\n\n1,2\n\n', b'a,"b\nc"\n"x""",y\n3,4', b'a"b,c\nd,e\n']
+        for msg in msgs:
+            for axis in (0, 1):
+                post1 = delimited_to_arrays(msg, axis=axis, preallocate=True)
+                post2 = delimited_to_arrays(msg, axis=axis)
+                self.assertEqual([a.tolist() for a in post1], [a.tolist() for a in post2])
+
+    def test_delimited_to_arrays_preallocate_b(self) -> None:
+        msg = b''.join(b'%d,%d.5,x,true\n' % (i, i) for i in range(10_000))
+        dtypes = [int, float, None, bool]
+        post1 = delimited_to_arrays(msg, axis=1, dtypes=dtypes, preallocate=True, skiprows=10, nrows=5000)
+        post2 = delimited_to_arrays(msg, axis=1, dtypes=dtypes, skiprows=10, nrows=5000)
+        self.assertEqual([a.tolist() for a in post1], [a.tolist() for a in post2])
+        self.assertEqual(post1[0][-1], 5009)
+
+    #---------------------------------------------------------------------------
+    def test_delimited_to_arrays_stream_a(self) -> None:
+        # records, quoted newlines, and multi-byte characters span block boundaries
+        import io
+        msg = '\n'.join(f'{i},"é\n{i}",{i * 0.5}' for i in range(200_000)).encode('utf-8')
+        post1 = delimited_to_arrays(io.BytesIO(msg), axis=1)
+        post2 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.dtype for a in post1], [a.dtype for a in post2])
+        self.assertEqual([a.tolist() for a in post1], [a.tolist() for a in post2])
+        self.assertEqual(post1[1][-1], 'é\n199999')
+
+    def test_delimited_to_arrays_stream_b(self) -> None:
+        import io
+        msg = b'a,b\n"1\n",2\n"x\ny",4\n5,6'
+        post1 = delimited_to_arrays(io.BytesIO(msg), axis=0, skiprows=2, nrows=1)
+        self.assertEqual([a.tolist() for a in post1], [['x\ny', '4']])
+        post2 = delimited_to_arrays(io.BytesIO(b''), axis=0)
+        self.assertEqual(post2, [])
+
+    def test_delimited_to_arrays_stream_c(self) -> None:
+        import io
+        class Failing(io.RawIOBase):
+            def readinto(self, b):
+                raise OSError('failed read')
+        with self.assertRaises(OSError):
+            delimited_to_arrays(Failing(), axis=0)
+        with self.assertRaises(UnicodeDecodeError):
+            delimited_to_arrays(io.BytesIO(b'a,b\nc,\xff\n'), axis=0)
+
+    def test_delimited_to_arrays_stream_d(self) -> None:
+        import io
+        msg = b'1,a\n2,b\n3,c\n4,d\n5,e'
+        post1 = list(iter_delimited_to_arrays(io.BytesIO(msg), chunk_records=2, axis=1))
+        self.assertEqual([a[0].tolist() for a in post1], [[1, 2], [3, 4], [5]])
+        schema = delimited_infer_schema(io.BytesIO(msg))
+        self.assertEqual(schema, ([np.dtype(int), np.dtype('<U1')], 5))
+
+    def test_delimited_to_arrays_stream_e(self) -> None:
+        # gzip input is detected and inflated, including concatenated members
+        import io
+        import gzip
+        msg = '\n'.join(f'{i},"é\n{i}"' for i in range(200_000)).encode('utf-8')
+        post1 = delimited_to_arrays(io.BytesIO(gzip.compress(msg)), axis=1)
+        post2 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post1], [a.tolist() for a in post2])
+        post3 = delimited_to_arrays(
+                io.BytesIO(gzip.compress(b'1,2\n3,') + gzip.compress(b'4\n5,6')),
+                axis=1)
+        self.assertEqual([a.tolist() for a in post3], [[1, 3, 5], [2, 4, 6]])
+
+    def test_delimited_to_arrays_stream_f(self) -> None:
+        import io
+        import gzip
+        msg = gzip.compress(b'1,2\n' * 1000)
+        with self.assertRaises(ValueError):
+            delimited_to_arrays(io.BytesIO(msg[:len(msg) // 2]), axis=1)
+        with self.assertRaises(ValueError):
+            delimited_to_arrays(io.BytesIO(msg[:10] + b'x' * 100), axis=1)
+
+    def test_delimited_to_arrays_stream_h(self) -> None:
+        # gzip is detected when reads return fewer bytes than the magic number
+        import io
+        import gzip
+
+        class OneByte(io.RawIOBase):
+            def __init__(self, data: bytes) -> None:
+                self.data = data
+                self.pos = 0
+            def readable(self) -> bool:
+                return True
+            def readinto(self, b) -> int: # type: ignore
+                if self.pos >= len(self.data):
+                    return 0
+                b[0] = self.data[self.pos]
+                self.pos += 1
+                return 1
+
+        post1 = delimited_to_arrays(OneByte(gzip.compress(b'1,2\n3,4')), axis=1)
+        self.assertEqual([a.tolist() for a in post1], [[1, 3], [2, 4]])
+        post2 = delimited_to_arrays(OneByte(b'\n1,2\n3,4'), axis=1)
+        self.assertEqual([a.tolist() for a in post2], [[1, 3], [2, 4]])
+        post3 = delimited_to_arrays(OneByte(b'1'), axis=1)
+        self.assertEqual([a.tolist() for a in post3], [[1]])
+
+    def test_delimited_to_arrays_stream_g(self) -> None:
+        # partial lines longer than the reserved head room are carried over
+        import io
+        msg = b'\n'.join(b'%d,%s' % (i, b'x' * (i * 7919 % 100_000))
+                for i in range(40))
+        post1 = delimited_to_arrays(io.BytesIO(msg), axis=1)
+        post2 = delimited_to_arrays(msg, axis=1)
+        self.assertEqual([a.tolist() for a in post1], [a.tolist() for a in post2])
+
+    #---------------------------------------------------------------------------
+    def test_delimited_infer_schema_a(self) -> None:
+        msg = ['a,b,c,d', '1,2.5,x,2020-01-01', '300,NA,yy,2020-01-02T00:00', '4,1e3,zzz,']
+        post1 = delimited_infer_schema(msg, skiprows=1, na_values=['NA'])
+        post2 = delimited_to_arrays(msg, axis=1, skiprows=1, na_values=['NA'])
+        self.assertEqual(post1, ([a.dtype for a in post2], 3))
+        self.assertEqual([str(d) for d in post1[0]], ['int64', 'float64', '<U3', 'datetime64[m]'])
+        post3 = delimited_infer_schema(msg, skiprows=1, narrow_int=True, nrows=1)
+        self.assertEqual([str(d) for d in post3[0]], ['int8', 'float64', '<U1', 'datetime64[D]'])
+        self.assertEqual(post3[1], 1)
+        self.assertEqual(delimited_infer_schema([]), ([], 0))
+
+    def test_delimited_infer_schema_b(self) -> None:
+        msg = b'1,a,2\n3,bb,4\n5,ccc,\n'
+        post1 = delimited_infer_schema(msg, line_select=[1, 2], dtypes={1: 'S'})
+        self.assertEqual(post1, ([np.dtype('S3'), np.dtype(np.int64)], 3))
+        post2 = delimited_infer_schema(msg, row_filter=(1, {'a', 'bb'}))
+        self.assertEqual(post2, ([np.dtype(np.int64), np.dtype('<U2'), np.dtype(np.int64)], 2))
+        with self.assertRaises(TypeError):
+            _ = delimited_infer_schema(msg, axis=1)
+
+    def test_delimited_infer_schema_c(self) -> None:
+        # a given datetime dtype without a unit is given the finest unit, as when loading
+        msg = ['2020-01-01T10,x', 'NaT,y', '2020-01-02T11:30,z']
+        for dtypes in (['datetime64'], lambda i: np.datetime64 if i == 0 else None):
+            post1 = delimited_infer_schema(msg, dtypes=dtypes)
+            post2 = delimited_to_arrays(msg, axis=1, dtypes=dtypes)
+            self.assertEqual(post1[0], [a.dtype for a in post2])
+            self.assertEqual(post1[0][0], np.dtype('<M8[m]'))
+
+    def test_delimited_infer_schema_d(self) -> None:
+        # lines of only empty fields have strings of at least one character
+        msg = [',', ',']
+        for dtypes in (None, [str, bytes]):
+            post1 = delimited_infer_schema(msg, dtypes=dtypes)
+            post2 = delimited_to_arrays(msg, axis=1, dtypes=dtypes)
+            self.assertEqual(post1[0], [a.dtype for a in post2])
+        self.assertEqual(post1[0], [np.dtype('<U1'), np.dtype('S1')])
+
+    #---------------------------------------------------------------------------
+    def test_iter_delimited_to_arrays_a(self) -> None:
+        msg = [f'{i},{i / 2},x{i},{i % 2 == 0}' for i in range(10)]
+        post = delimited_to_arrays(msg, axis=1)
+        chunks = list(iter_delimited_to_arrays(msg, chunk_records=4, axis=1))
+        self.assertEqual([len(c[0]) for c in chunks], [4, 4, 2])
+        for i, a in enumerate(post):
+            self.assertEqual(np.concatenate([c[i] for c in chunks]).tolist(), a.tolist())
+            self.assertEqual(chunks[0][i].dtype, a.dtype)
+
+    def test_iter_delimited_to_arrays_b(self) -> None:
+        # dtypes and line_select are given the position of the record in all records
+        msg = ('\n'.join(f'{i},{i}' for i in range(7)) + '\n').encode('utf-8')
+        chunks = list(iter_delimited_to_arrays(msg,
+                chunk_records=2,
+                axis=0,
+                dtypes=lambda i: str if i == 2 else None,
+                line_select=lambda i: i != 3,
+                ))
+        self.assertEqual([[a.tolist() for a in c] for c in chunks],
+                [[[0, 0], [1, 1]], [['2', '2'], [4, 4]], [[5, 5], [6, 6]]])
+
+    def test_iter_delimited_to_arrays_c(self) -> None:
+        # lines widened in one chunk are reused in the next
+        msg = ['\U0001F600,1', 'b,2', 'c,3', 'd,4']
+        chunks = list(iter_delimited_to_arrays(msg, chunk_records=2, axis=1))
+        self.assertEqual([[a.tolist() for a in c] for c in chunks],
+                [[['\U0001F600', 'b'], [1, 2]], [['c', 'd'], [3, 4]]])
+
+    def test_iter_delimited_to_arrays_d(self) -> None:
+        self.assertEqual(list(iter_delimited_to_arrays([], chunk_records=2)), [])
+        self.assertEqual(len(list(iter_delimited_to_arrays(['1', '2'], chunk_records=2))), 1)
+        with self.assertRaises(ValueError):
+            iter_delimited_to_arrays(['1', '2'])
+        with self.assertRaises(ValueError):
+            iter_delimited_to_arrays(['1', '2'], chunk_records=2, axis=3)
+
+    def test_iter_delimited_to_arrays_e(self) -> None:
+        it = iter_delimited_to_arrays(['1', '2', '"x'], chunk_records=2, axis=1, strict=True)
+        self.assertEqual(next(it)[0].tolist(), [1, 2])
+        with self.assertRaises(RuntimeError):
+            next(it)
+        with self.assertRaises(StopIteration):
+            next(it)
+
+    def test_iter_delimited_to_arrays_f(self) -> None:
+        # line_select positions are of all records, dtypes positions of selected records
+        msg = ['1,2', '3,4', '5,6', '7,8']
+        it = iter_delimited_to_arrays(msg, chunk_records=2, axis=0,
+                dtypes={2: str}, line_select=np.array([True, False, True, True]))
+        post = [[x.tolist() for x in arrays] for arrays in it]
+        self.assertEqual(post, [[[1, 2], [5, 6]], [['7', '8']]])
+
+    def test_iter_delimited_to_arrays_g(self) -> None:
+        # records that fail the row_filter are not counted in chunk_records
+        msg = ['a,1', 'b,2', 'a,3', 'a,4', 'b,5']
+        it = iter_delimited_to_arrays(msg, chunk_records=2, axis=1, row_filter=(0, 'a'))
+        post = [[x.tolist() for x in arrays] for arrays in it]
+        self.assertEqual(post, [[['a', 'a'], [1, 3]], [['a'], [4]]])
+
+    def test_iter_delimited_to_arrays_h(self) -> None:
+        msg = ['h1,h2', '1,2', '3,4', '5,6', '7,8']
+        it = iter_delimited_to_arrays(msg, chunk_records=2, axis=1, skiprows=1, nrows=3)
+        post = [[x.tolist() for x in arrays] for arrays in it]
+        self.assertEqual(post, [[[1, 3], [2, 4]], [[5], [6]]])
+
+    def test_iter_delimited_to_arrays_i(self) -> None:
+        # an iterator in a reference cycle through its dtypes callable is collected
+        class DTypes:
+            def __call__(self, i):
+                return None
+        dtypes = DTypes()
+        it = iter_delimited_to_arrays(['1,2', '3,4'], chunk_records=1, axis=0, dtypes=dtypes)
+        dtypes.it = it
+        ref = weakref.ref(dtypes)
+        del dtypes, it
+        gc.collect()
+        self.assertIsNone(ref())
+
+    def test_iter_delimited_to_arrays_j(self) -> None:
+        # a callable calling next() on the iterator it serves raises
+        msg = [f'{i},{i}' for i in range(12)]
+        for axis in (0, 1):
+            errors = []
+            def dtypes(i):
+                try:
+                    next(it)
+                except ValueError as e:
+                    errors.append(str(e))
+                return None
+            it = iter_delimited_to_arrays(msg, chunk_records=5, axis=axis, dtypes=dtypes)
+            post1 = [[a.tolist() for a in arrays] for arrays in it]
+            post2 = [[a.tolist() for a in arrays]
+                    for arrays in iter_delimited_to_arrays(msg, chunk_records=5, axis=axis)]
+            self.assertEqual(post1, post2)
+            self.assertTrue(errors)
+            self.assertEqual(set(errors), {'iterator already executing'})
+
     #---------------------------------------------------------------------------
     def test_delimited_to_arrays_compare_int_a(self) -> None:
         # genfromtxt might translate an empty field to -1 or 0